@@ -0,0 +1,1193 @@
+/**
+ * @brief Benchmarks for the eop algorithms, on Google Benchmark
+ * 
+ * Besides time per iteration, each benchmark reports per-iteration
+ * counters: f_calls (applications of the transformation),
+ * bytes_allocated (through global operator new) and cache_misses
+ * (through perf_event, when the kernel allows it; omitted
+ * otherwise). Use --benchmark_out=<file> --benchmark_out_format=json,
+ * or the eop_bench_json target, to record a run for comparison.
+ * 
+ */
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "eop/ch-01/founds.hpp"
+#include "eop/ch-02/transorbs.hpp"
+#include "eop/ch-02/norms.hpp"
+#include "eop/ch-02/tabulated.hpp"
+#include "eop/ch-02/jump_tables.hpp"
+#include "eop/ch-02/orbit_view.hpp"
+#include "eop/ch-02/checkpointed_orbits.hpp"
+#include "eop/ch-02/interleaved_orbits.hpp"
+#include "eop/ch-02/composition.hpp"
+#include "eop/ch-03/reductions.hpp"
+#include "eop/ch-11/partitions.hpp"
+#include "eop/instrumented.hpp"
+#include "eop/flat_hash.hpp"
+
+namespace
+{
+    std::atomic<std::uint64_t> allocated_bytes{0};
+} // namespace
+
+namespace
+{
+    // Out of line, so that the compiler never pairs a malloc it
+    // can see in operator new with a free it can see in operator
+    // delete (-Wmismatched-new-delete)
+    [[gnu::noinline]] void* counted_allocate(std::size_t n, std::size_t alignment) noexcept
+    {
+        allocated_bytes.fetch_add(n, std::memory_order_relaxed);
+        if (n == 0) n = 1;
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) return std::malloc(n);
+        return std::aligned_alloc(alignment, (n + alignment - 1) & ~(alignment - 1));
+    }
+
+    [[gnu::noinline]] void counted_deallocate(void* p) noexcept
+    {
+        std::free(p);
+    }
+
+    void* counted_allocate_or_throw(std::size_t n, std::size_t alignment)
+    {
+        if (void* p = counted_allocate(n, alignment)) return p;
+        throw std::bad_alloc();
+    }
+} // namespace
+
+void* operator new(std::size_t n)
+{
+    return counted_allocate_or_throw(n, 0);
+}
+
+void* operator new[](std::size_t n)
+{
+    return counted_allocate_or_throw(n, 0);
+}
+
+void* operator new(std::size_t n, std::align_val_t a)
+{
+    return counted_allocate_or_throw(n, std::size_t(a));
+}
+
+void* operator new[](std::size_t n, std::align_val_t a)
+{
+    return counted_allocate_or_throw(n, std::size_t(a));
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(n, 0);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(n, 0);
+}
+
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(n, std::size_t(a));
+}
+
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(n, std::size_t(a));
+}
+
+void operator delete(void* p) noexcept { counted_deallocate(p); }
+void operator delete[](void* p) noexcept { counted_deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_deallocate(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_deallocate(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_deallocate(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_deallocate(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_deallocate(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { counted_deallocate(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { counted_deallocate(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_deallocate(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_deallocate(p); }
+
+namespace eop_bench
+{
+    /**
+     * @brief Hardware cache-miss counter for the calling
+     * thread, inert when perf_event is unavailable
+     * 
+     */
+    class cache_miss_counter
+    {
+    private:
+        int _fd = -1;
+
+    public:
+        cache_miss_counter() noexcept
+        {
+        #if defined(__linux__)
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            _fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (_fd >= 0)
+            {
+                ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        #endif
+        }
+
+        cache_miss_counter(const cache_miss_counter&) = delete;
+        cache_miss_counter &operator=(const cache_miss_counter&) = delete;
+
+        ~cache_miss_counter()
+        {
+        #if defined(__linux__)
+            if (_fd >= 0) close(_fd);
+        #endif
+        }
+
+        bool available() const noexcept
+        {
+            return _fd >= 0;
+        }
+
+        std::uint64_t read() const noexcept
+        {
+            std::uint64_t n = 0;
+        #if defined(__linux__)
+            if (_fd >= 0 && ::read(_fd, &n, sizeof(n)) != ssize_t(sizeof(n))) n = 0;
+        #endif
+            return n;
+        }
+    };
+
+    /**
+     * @brief Records allocations and cache misses from its
+     * construction, and reports them per iteration
+     * 
+     */
+    class probe
+    {
+    private:
+        std::uint64_t _bytes;
+        cache_miss_counter _misses;
+
+    public:
+        probe() noexcept : _bytes(allocated_bytes.load(std::memory_order_relaxed)) {}
+
+        void report(benchmark::State& state, std::uint64_t f_calls = 0) const
+        {
+            using benchmark::Counter;
+            // Read before inserting counters, which allocates
+            double bytes = double(allocated_bytes.load(std::memory_order_relaxed) - _bytes);
+            double misses = double(_misses.read());
+            state.counters["bytes_allocated"] = Counter(bytes, Counter::kAvgIterations);
+            if (_misses.available())
+                state.counters["cache_misses"] = Counter(misses, Counter::kAvgIterations);
+            if (f_calls != 0)
+                state.counters["f_calls"] = Counter(double(f_calls), Counter::kAvgIterations);
+        }
+    };
+
+    /**
+     * @brief $x \mapsto (a x + b) \bmod m$, counting its calls
+     * 
+     * @tparam _Tp An unsigned integral type
+     */
+    template< class _Tp >
+    struct affine
+    {
+        _Tp a, b, m;
+        std::uint64_t* calls;
+
+        _Tp operator()(_Tp x) const noexcept
+        {
+            ++*calls;
+            return _Tp((unsigned __int128)(a) * x % m + b) % m;
+        }
+    };
+
+    /**
+     * @brief The same map, with a composition law
+     * 
+     * @tparam _Tp An unsigned integral type
+     */
+    template< class _Tp >
+    struct composable_affine : affine<_Tp> {};
+
+    /**
+     * @brief $x \mapsto x^2 + 1 \bmod m$, counting its calls
+     * 
+     * @tparam _Tp An unsigned integral type
+     */
+    template< class _Tp >
+    struct square_plus_one
+    {
+        _Tp m;
+        std::uint64_t* calls;
+
+        _Tp operator()(_Tp x) const noexcept
+        {
+            ++*calls;
+            return _Tp(((unsigned __int128)(x) * x + 1) % m);
+        }
+    };
+
+    struct point3
+    {
+        int x, y, z;
+    };
+
+    /**
+     * @brief A transformation given by a table, optionally
+     * hinting the entry it reads next
+     * 
+     */
+    template< bool Hint >
+    struct table_step
+    {
+        const std::uint32_t* table;
+
+        std::uint32_t operator()(std::uint32_t x) const noexcept
+        {
+            return table[x];
+        }
+    };
+
+    /**
+     * @brief A type-erased transformation, as with a composition
+     * built from std::function
+     * 
+     */
+    struct erased_step
+    {
+        std::function<std::uint64_t(std::uint64_t)> f;
+
+        std::uint64_t operator()(std::uint64_t x) const
+        {
+            return f(x);
+        }
+    };
+
+    /**
+     * @brief An owning handle whose move constructor and
+     * destructor are out of line, as for a type defined in
+     * another translation unit, declared trivially relocatable
+     * 
+     */
+    struct opaque_handle
+    {
+        std::uint64_t* p;
+
+        explicit opaque_handle(std::size_t i) : p(new std::uint64_t(i)) {}
+
+        [[gnu::noinline]] opaque_handle(opaque_handle&& x) noexcept : p(x.p)
+        {
+            x.p = nullptr;
+        }
+
+        [[gnu::noinline]] ~opaque_handle()
+        {
+            delete p;
+        }
+    };
+
+    /**
+     * @brief A random cyclic permutation of $[0, 2^k)$, by
+     * Sattolo's algorithm, built once per size
+     * 
+     */
+    const std::vector<std::uint32_t>& random_cycle(int k)
+    {
+        static std::vector<std::vector<std::uint32_t>> cycles(32);
+        std::vector<std::uint32_t>& t = cycles[std::size_t(k)];
+        if (t.empty())
+        {
+            t.resize(std::size_t(1) << k);
+            std::iota(t.begin(), t.end(), std::uint32_t(0));
+            std::mt19937_64 g(7);
+            for (std::size_t i = t.size() - 1; i > 0; --i)
+                std::swap(t[i], t[g() % i]);
+        }
+        return t;
+    }
+} // namespace eop_bench
+
+namespace eop
+{
+    template< class _Tp >
+    struct input<eop_bench::affine<_Tp>, 0> { using type = _Tp; };
+    template< class _Tp >
+    struct distance<eop_bench::affine<_Tp>> { using type = std::uint64_t; };
+    template< class _Tp >
+    struct input<eop_bench::composable_affine<_Tp>, 0> { using type = _Tp; };
+    template< class _Tp >
+    struct distance<eop_bench::composable_affine<_Tp>> { using type = std::uint64_t; };
+    template< class _Tp >
+    struct input<eop_bench::square_plus_one<_Tp>, 0> { using type = _Tp; };
+    template< class _Tp >
+    struct distance<eop_bench::square_plus_one<_Tp>> { using type = std::uint64_t; };
+
+    template< bool Hint >
+    struct input<eop_bench::table_step<Hint>, 0> { using type = std::uint32_t; };
+
+    template<>
+    struct input<eop_bench::erased_step, 0> { using type = std::uint64_t; };
+
+    template<>
+    struct is_trivially_relocatable<eop_bench::opaque_handle> : std::true_type {};
+
+    template<>
+    struct prefetch_hint<eop_bench::table_step<true>>
+    {
+        static void prefetch(const eop_bench::table_step<true>& f, std::uint32_t x) noexcept
+        {
+            eop::prefetch(f.table + x);
+        }
+    };
+
+    template< class _Tp >
+    struct composition<eop_bench::composable_affine<_Tp>>
+    {
+        using F = eop_bench::composable_affine<_Tp>;
+
+        static F compose(const F& f, const F& g) noexcept
+        {
+            _Tp a = _Tp((unsigned __int128)(f.a) * g.a % f.m);
+            _Tp b = _Tp(((unsigned __int128)(f.a) * g.b + f.b) % f.m);
+            return F{ { a, b, f.m, f.calls } };
+        }
+
+        static F identity(const F& f) noexcept
+        {
+            return F{ { _Tp(1), _Tp(0), f.m, f.calls } };
+        }
+    };
+} // namespace eop
+
+namespace eop_bench
+{
+    template< class _Tp >
+    void power_unary_linear(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        affine<_Tp> f{ _Tp(48271), _Tp(11), _Tp(2147483647), &calls };
+        std::uint64_t n = std::uint64_t(state.range(0));
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::power_unary(_Tp(1), n, f));
+        p.report(state, calls);
+    }
+
+    template< class _Tp >
+    void power_unary_composable(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        composable_affine<_Tp> f{ { _Tp(48271), _Tp(11), _Tp(2147483647), &calls } };
+        std::uint64_t n = std::uint64_t(state.range(0));
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::power_unary(_Tp(1), n, f));
+        p.report(state, calls);
+    }
+
+    template< class _Tp, bool Timed >
+    void power_unary_instrumented(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        eop::instrumented<affine<_Tp>, Timed> f(
+            affine<_Tp>{ _Tp(48271), _Tp(11), _Tp(2147483647), &calls });
+        std::uint64_t n = std::uint64_t(state.range(0));
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::power_unary(_Tp(1), n, f));
+        p.report(state, calls);
+        if (Timed)
+        {
+            eop::instrument_stats s = f.stats();
+            state.counters["p50_ticks"] = double(s.latency.value_at_quantile(0.5));
+            state.counters["p99_ticks"] = double(s.latency.value_at_quantile(0.99));
+        }
+    }
+
+    template< class _Tp >
+    void orbit_distance(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        affine<_Tp> f{ _Tp(1), _Tp(1), _Tp(state.range(0)), &calls };
+        benchmark::DoNotOptimize(f);
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::orbit_distance(_Tp(0), _Tp(state.range(0) - 1), f));
+        p.report(state, calls);
+    }
+
+    template< class _Tp >
+    void orbit_distance_checkpointed(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        affine<_Tp> f{ _Tp(1), _Tp(1), _Tp(state.range(0)), &calls };
+        benchmark::DoNotOptimize(f);
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "eop_bench.ckpt";
+        probe p;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            std::filesystem::remove(path);
+            eop::file_checkpoint c(path, ~std::uint64_t(0), std::chrono::seconds(1));
+            state.ResumeTiming();
+            benchmark::DoNotOptimize(eop::orbit_distance(_Tp(0), _Tp(state.range(0) - 1), f, c));
+        }
+        p.report(state, calls);
+        std::filesystem::remove(path);
+    }
+
+    template< class _Tp >
+    void orbit_structure_floyd(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        square_plus_one<_Tp> f{ _Tp(state.range(0)), &calls };
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::orbit_structure_nonterminating_orbit(_Tp(2), f));
+        p.report(state, calls);
+    }
+
+    template< class _Tp >
+    void orbit_structure_brent(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        square_plus_one<_Tp> f{ _Tp(state.range(0)), &calls };
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::orbit_structure_brent_nonterminating_orbit(_Tp(2), f));
+        p.report(state, calls);
+    }
+
+    template< class _Tp >
+    void orbit_view_reduce(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        square_plus_one<_Tp> f{ _Tp(state.range(0)), &calls };
+        auto v = eop::orbit_view(_Tp(2), f).until_cycle();
+        calls = 0;
+        probe p;
+        for (auto _ : state)
+        {
+            auto r = v | std::views::transform([](_Tp x) { return std::uint64_t(x & _Tp(0xff)); })
+                | std::views::common;
+            benchmark::DoNotOptimize(std::accumulate(r.begin(), r.end(), std::uint64_t(0)));
+        }
+        p.report(state, calls);
+    }
+
+    void power_unary_tabulated(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        square_plus_one<std::uint16_t> g{ std::uint16_t(65521), &calls };
+        eop::tabulated<square_plus_one<std::uint16_t>> f(g, eop::tabulation::eager);
+        calls = 0;
+        std::uint64_t n = std::uint64_t(state.range(0));
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::power_unary(std::uint16_t(2), n, f));
+        p.report(state, calls);
+    }
+
+    void power_unary_jump_table(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        square_plus_one<std::uint16_t> g{ std::uint16_t(65521), &calls };
+        eop::jump_table<square_plus_one<std::uint16_t>> f(g, std::size_t(1) << 16);
+        calls = 0;
+        std::uint64_t n = std::uint64_t(state.range(0));
+        std::uint16_t x = 0;
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(f.power(++x, n));
+        p.report(state, calls);
+    }
+
+    void tabulated_analyze(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        square_plus_one<std::uint32_t> g{ std::uint32_t(state.range(0)), &calls };
+        eop::tabulated<square_plus_one<std::uint32_t>> f(g, std::size_t(state.range(0)),
+            eop::tabulation::eager);
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::analyze_table<square_plus_one<std::uint32_t>>(
+                f.data(), f.size()));
+        p.report(state);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template< class _Tp >
+    std::vector<_Tp> random_values(std::size_t n)
+    {
+        std::mt19937_64 g(42);
+        std::uniform_real_distribution<double> u(-1.0, 1.0);
+        std::vector<_Tp> x(n);
+        for (auto& v : x) v = _Tp(u(g));
+        return x;
+    }
+
+    template< class _Tp, eop::summation S >
+    void euclidean_norm_n(benchmark::State& state)
+    {
+        std::vector<_Tp> x = random_values<_Tp>(std::size_t(state.range(0)));
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::euclidean_norm_n(x.data(), x.size(), S));
+        p.report(state);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template< class _Tp >
+    void euclidean_norm_n_scalar(benchmark::State& state)
+    {
+        std::vector<_Tp> x = random_values<_Tp>(std::size_t(state.range(0)));
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::euclidean_norm_n(x.data(), x.size(),
+                eop::summation::naive, eop::simd_level::scalar));
+        p.report(state);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template< class _Tp, eop::norm_kernel K >
+    void point_norms(benchmark::State& state)
+    {
+        std::vector<_Tp> x = random_values<_Tp>(3 * std::size_t(state.range(0)));
+        std::vector<_Tp> out(std::size_t(state.range(0)));
+        eop::euclidean_norm<_Tp, 3, K> norm;
+        probe p;
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < out.size(); ++i)
+                out[i] = norm(x[3 * i], x[3 * i + 1], x[3 * i + 2]);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        p.report(state);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template< class _Tp >
+    void point_norms_hypot(benchmark::State& state)
+    {
+        std::vector<_Tp> x = random_values<_Tp>(3 * std::size_t(state.range(0)));
+        std::vector<_Tp> out(std::size_t(state.range(0)));
+        probe p;
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < out.size(); ++i)
+                out[i] = std::hypot(x[3 * i], x[3 * i + 1], x[3 * i + 2]);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        p.report(state);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template< class _Tp >
+    void euclidean_distances_soa(benchmark::State& state)
+    {
+        constexpr std::size_t dim = 3;
+        std::size_t n = std::size_t(state.range(0));
+        std::vector<std::vector<_Tp>> x, y;
+        std::vector<const _Tp*> px, py;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            x.push_back(random_values<_Tp>(n));
+            y.push_back(random_values<_Tp>(n));
+        }
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            px.push_back(x[d].data());
+            py.push_back(y[d].data());
+        }
+        std::vector<_Tp> out(n);
+        probe p;
+        for (auto _ : state)
+        {
+            eop::euclidean_distances_soa(px.data(), py.data(), dim, n, out.data());
+            benchmark::ClobberMemory();
+        }
+        p.report(state);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template< class _Tp >
+    _Tp make_value(std::size_t i)
+    {
+        if constexpr (std::is_same_v<_Tp, std::string>) return std::string(24, char('a' + i % 26));
+        else return _Tp(i);
+    }
+
+    template< class _Tp >
+    void lexicographical_equal(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        std::vector<_Tp> x, y;
+        for (std::size_t i = 0; i < n; ++i) x.push_back(make_value<_Tp>(i));
+        y = x;
+        probe p;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(eop::lexicographical_equal(x, y));
+        p.report(state);
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(_Tp));
+    }
+
+    template< class _Tp >
+    void construct_destruct_range(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        _Tp* buffer = static_cast<_Tp*>(::operator new(n * sizeof(_Tp)));
+        _Tp init{};
+        probe p;
+        for (auto _ : state)
+        {
+            eop::construct_range(buffer, buffer + n, init);
+            benchmark::ClobberMemory();
+            eop::destruct_range(buffer, buffer + n);
+        }
+        p.report(state);
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(_Tp));
+        ::operator delete(buffer);
+    }
+
+    void ptr_construct_heap(benchmark::State& state)
+    {
+        probe p;
+        for (auto _ : state)
+        {
+            auto x = eop::unique_ptr_construct<point3>(point3{ 1, 2, 3 });
+            benchmark::DoNotOptimize(x.get());
+        }
+        p.report(state);
+    }
+
+    void ptr_construct_arena(benchmark::State& state)
+    {
+        eop::arena a;
+        probe p;
+        std::size_t k = 0;
+        for (auto _ : state)
+        {
+            auto x = eop::ptr_construct<point3>(a, point3{ 1, 2, 3 });
+            benchmark::DoNotOptimize(x.get());
+            if (++k == 4096)
+            {
+                a.reset();
+                k = 0;
+            }
+        }
+        p.report(state);
+    }
+
+    void ptr_construct_pool(benchmark::State& state)
+    {
+        eop::pool<point3> pool;
+        probe p;
+        for (auto _ : state)
+        {
+            auto x = eop::ptr_construct(pool, point3{ 1, 2, 3 });
+            benchmark::DoNotOptimize(x.get());
+        }
+        p.report(state);
+    }
+
+    /**
+     * @brief A buffer handed between pipeline stages
+     * 
+     */
+    struct message
+    {
+        std::uint64_t seq;
+        unsigned char bytes[248];
+
+        explicit message(std::uint64_t s) noexcept : seq(s) {}
+    };
+
+    template< class H, class Access >
+    H pipeline_stage(H h, Access access, unsigned char tag)
+    {
+        message& m = access(h);
+        m.bytes[m.seq % sizeof(m.bytes)] = tag;
+        return h;
+    }
+
+    void handoff_unique_ptr(benchmark::State& state)
+    {
+        auto access = [](std::unique_ptr<message>& h) -> message& { return *h; };
+        std::uint64_t seq = 0;
+        probe p;
+        for (auto _ : state)
+        {
+            auto h = std::make_unique<message>(seq++);
+            h = pipeline_stage(std::move(h), access, 1);
+            h = pipeline_stage(std::move(h), access, 2);
+            h = pipeline_stage(std::move(h), access, 3);
+            benchmark::DoNotOptimize(h->bytes[0]);
+        }
+        p.report(state);
+    }
+
+    void handoff_linear_slab(benchmark::State& state)
+    {
+        eop::linear_slab<message> slab(1024);
+        auto access = [&](eop::linear_handle<message>& h) -> message& { return slab[h]; };
+        std::uint64_t seq = 0;
+        probe p;
+        for (auto _ : state)
+        {
+            auto h = slab.emplace(seq++);
+            h = pipeline_stage(std::move(h), access, 1);
+            h = pipeline_stage(std::move(h), access, 2);
+            h = pipeline_stage(std::move(h), access, 3);
+            benchmark::DoNotOptimize(slab[h].bytes[0]);
+            slab.release(std::move(h));
+        }
+        p.report(state);
+    }
+    /**
+     * @brief Inserts n random keys into an empty set, then looks
+     * up each of them and as many absent keys
+     * 
+     */
+    template< class Set >
+    void hash_set_insert_find(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        std::mt19937_64 g(42);
+        std::vector<std::uint64_t> present(n);
+        std::vector<std::uint64_t> absent(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            present[i] = g() | 1;
+            absent[i] = g() & ~std::uint64_t(1);
+        }
+        probe p;
+        for (auto _ : state)
+        {
+            Set s;
+            for (std::uint64_t k : present) s.insert(k);
+            std::size_t found = 0;
+            for (std::uint64_t k : present) found += s.count(k);
+            for (std::uint64_t k : absent) found += s.count(k);
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(3 * n));
+        p.report(state);
+    }
+
+    /**
+     * @brief Finds the size of the orbit of 2 under
+     * $x \mapsto x^2 + 1 \bmod (m - 1)$ by recording every
+     * element visited until one repeats
+     * 
+     */
+    template< class Set >
+    void orbit_visited(benchmark::State& state)
+    {
+        std::uint64_t calls = 0;
+        square_plus_one<std::uint64_t> f{ std::uint64_t(state.range(0) - 1), &calls };
+        probe p;
+        for (auto _ : state)
+        {
+            Set visited;
+            std::uint64_t x = 2;
+            while (visited.insert(x).second) x = f(x);
+            benchmark::DoNotOptimize(visited.size());
+        }
+        p.report(state, calls);
+    }
+    /**
+     * @brief 64 steps from each of 1024 random seeds on a random
+     * cycle of $2^k$ elements, one orbit at a time for K = 1 or K
+     * interleaved orbits otherwise
+     * 
+     */
+    template< std::size_t K, bool Hint >
+    void power_unary_table(benchmark::State& state)
+    {
+        const std::vector<std::uint32_t>& t = random_cycle(int(state.range(0)));
+        table_step<Hint> f{ t.data() };
+        std::mt19937_64 g(11);
+        std::vector<std::uint32_t> seeds(1024);
+        std::vector<std::uint32_t> out(seeds.size());
+        for (std::uint32_t& x : seeds) x = std::uint32_t(g() % t.size());
+        probe p;
+        for (auto _ : state)
+        {
+            if constexpr (K == 1)
+                for (std::size_t i = 0; i < seeds.size(); ++i)
+                    out[i] = eop::power_unary(seeds[i], 64, f);
+            else
+                eop::power_unary_interleaved<K>(seeds.begin(), seeds.end(), 64, f, out.begin());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(std::int64_t(state.iterations()) * 64 * 1024);
+        p.report(state);
+    }
+
+    /**
+     * @brief Distances to a common target from 64 seeds at
+     * random distances in $[0, 2^{14})$ behind it on a random
+     * cycle of $2^k$ elements
+     * 
+     */
+    template< std::size_t K, bool Hint >
+    void orbit_distances_table(benchmark::State& state)
+    {
+        const std::vector<std::uint32_t>& t = random_cycle(int(state.range(0)));
+        table_step<Hint> f{ t.data() };
+        std::vector<std::uint32_t> window(std::size_t(1) << 14);
+        window[0] = 0;
+        for (std::size_t i = 1; i < window.size(); ++i) window[i] = f(window[i - 1]);
+        std::uint32_t y = f(window.back());
+        std::mt19937_64 g(13);
+        std::vector<std::uint32_t> seeds(64);
+        std::vector<std::uint64_t> out(seeds.size());
+        std::uint64_t steps = 0;
+        for (std::uint32_t& x : seeds)
+        {
+            std::size_t r = std::size_t(g() % window.size());
+            steps += window.size() - r;
+            x = window[r];
+        }
+        probe p;
+        for (auto _ : state)
+        {
+            if constexpr (K == 1)
+                for (std::size_t i = 0; i < seeds.size(); ++i)
+                    out[i] = eop::orbit_distance(seeds[i], y, f);
+            else
+                eop::orbit_distances_interleaved<K>(seeds.begin(), seeds.end(), y, f, out.begin());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(steps));
+        p.report(state);
+    }
+    enum class chain { erased, composed, fused };
+
+    /**
+     * @brief Walks n steps of $f \circ g \circ h$ for three affine
+     * maps with eop::orbit_distance, composed behind a
+     * std::function, nested with eop::composed, or fused by
+     * eop::compose into a single affine map
+     * 
+     */
+    template< chain C >
+    void compose_affine_chain(benchmark::State& state)
+    {
+        using A = eop::affine<std::uint64_t>;
+        A f{ 0x9E3779B97F4A7C15ull, 1 };
+        A g{ 0xBF58476D1CE4E5B9ull, 3 };
+        A h{ 0x94D049BB133111EBull, 5 };
+        auto step = [&]
+        {
+            if constexpr (C == chain::erased)
+                return erased_step{ [=](std::uint64_t x) { return f(g(h(x))); } };
+            else if constexpr (C == chain::composed)
+                return eop::composed<A, eop::composed<A, A>>{ f, { g, h } };
+            else
+                return eop::compose(f, g, h);
+        }();
+        std::uint64_t n = std::uint64_t(state.range(0));
+        std::uint64_t y = 2;
+        for (std::uint64_t i = 0; i < n; ++i) y = f(g(h(y)));
+        probe p;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(step);
+            benchmark::DoNotOptimize(eop::orbit_distance(std::uint64_t(2), y, step));
+        }
+        state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(n));
+        p.report(state);
+    }
+    /**
+     * @brief Relocates n handles between two buffers and back,
+     * as on buffer growth, with eop::relocate or with a move
+     * construction and destruction per element
+     * 
+     */
+    template< class P, bool Bulk >
+    void relocate_buffer(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        std::allocator<P> alloc;
+        P* a = alloc.allocate(n);
+        P* b = alloc.allocate(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if constexpr (std::is_same_v<P, opaque_handle>)
+                ::new (static_cast<void*>(a + i)) P(i);
+            else
+                ::new (static_cast<void*>(a + i)) P(new int(int(i)));
+        }
+        auto move = [](P* f, P* l, P* d)
+        {
+            if constexpr (Bulk)
+                eop::relocate(f, l, d);
+            else
+                for (; f != l; ++f, ++d)
+                {
+                    std::construct_at(d, std::move(*f));
+                    std::destroy_at(f);
+                }
+        };
+        probe p;
+        for (auto _ : state)
+        {
+            move(a, a + n, b);
+            benchmark::ClobberMemory();
+            move(b, b + n, a);
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(2 * n * sizeof(P)));
+        p.report(state);
+        eop::destruct_range(a, a + n);
+        alloc.deallocate(a, n);
+        alloc.deallocate(b, n);
+    }
+    enum class fold { accumulate, unrolled, balanced, parallel };
+
+    /**
+     * @brief Sums n doubles with a left fold (std::accumulate),
+     * eop::reduce_unrolled, eop::reduce_balanced or
+     * eop::reduce_parallel on the default pool
+     * 
+     */
+    template< fold Fold >
+    void reduce_doubles(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        std::mt19937_64 g(7);
+        std::uniform_real_distribution<double> u(-1.0, 1.0);
+        std::vector<double> v(n);
+        for (double& x : v) x = u(g);
+        probe p;
+        for (auto _ : state)
+        {
+            double r;
+            if constexpr (Fold == fold::accumulate)
+                r = std::accumulate(v.begin(), v.end(), 0.0);
+            else if constexpr (Fold == fold::unrolled)
+                r = eop::reduce(v.begin(), v.end(), std::plus<double>(), 0.0);
+            else if constexpr (Fold == fold::balanced)
+                r = eop::reduce_balanced(v.begin(), v.end(), std::plus<double>(), 0.0);
+            else
+                r = eop::reduce_parallel(v.begin(), v.end(), std::plus<double>(), 0.0);
+            benchmark::DoNotOptimize(r);
+        }
+        state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(n * sizeof(double)));
+        p.report(state);
+    }
+
+    /**
+     * @brief Inclusive prefix sums of n 64-bit integers, with
+     * std::partial_sum, eop::inclusive_scan or
+     * eop::inclusive_scan_parallel on the default pool
+     * 
+     */
+    template< fold Fold >
+    void scan_integers(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        std::vector<std::uint64_t> v(n);
+        std::vector<std::uint64_t> out(n);
+        std::iota(v.begin(), v.end(), std::uint64_t(1));
+        probe p;
+        for (auto _ : state)
+        {
+            if constexpr (Fold == fold::accumulate)
+                std::partial_sum(v.begin(), v.end(), out.begin());
+            else if constexpr (Fold == fold::unrolled)
+                eop::inclusive_scan(v.begin(), v.end(), out.begin(), std::plus<>());
+            else
+                eop::inclusive_scan_parallel(v.begin(), v.end(), out.begin(), std::plus<>(),
+                    eop::default_pool());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(n * sizeof(std::uint64_t)));
+        p.report(state);
+    }
+    enum class rotation { cycles, reversals, block_swaps, buffer, dispatched, standard };
+
+    /**
+     * @brief Rotates n 64-bit integers by k, or by about n / 3
+     * for k = 0, with each eop rotation, eop::rotate, and
+     * std::rotate
+     * 
+     */
+    template< rotation R >
+    void rotate_integers(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        std::size_t k = state.range(1) ? std::size_t(state.range(1)) : n / 3 + 1;
+        std::vector<std::uint64_t> v(n);
+        std::iota(v.begin(), v.end(), std::uint64_t(0));
+        eop::temporary_buffer<std::uint64_t> b{ R == rotation::buffer ? n : 0 };
+        auto f = v.begin();
+        probe p;
+        for (auto _ : state)
+        {
+            if constexpr (R == rotation::cycles)
+                eop::rotate_cycles(f, f + k, v.end());
+            else if constexpr (R == rotation::reversals)
+                eop::rotate_bidirectional_nontrivial(f, f + k, v.end());
+            else if constexpr (R == rotation::block_swaps)
+                eop::rotate_block_swaps(f, f + k, v.end());
+            else if constexpr (R == rotation::buffer)
+                eop::rotate_adaptive(f, f + k, v.end(), b.data(), std::ptrdiff_t(b.size()));
+            else if constexpr (R == rotation::dispatched)
+                eop::rotate(f, f + k, v.end());
+            else
+                std::rotate(f, f + k, v.end());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(n * sizeof(std::uint64_t)));
+        p.report(state);
+    }
+
+    /**
+     * @brief Stable partition of n records of three ints on a
+     * random bit of the first, with eop::partition_stable,
+     * in place with eop::partition_stable_n, and with
+     * std::stable_partition
+     * 
+     */
+    enum class partitioning { buffered, in_place, standard };
+
+    template< partitioning Kind >
+    void stable_partition_records(benchmark::State& state)
+    {
+        std::size_t n = std::size_t(state.range(0));
+        std::vector<point3> v(n);
+        std::mt19937_64 g(11);
+        for (point3& x : v) x = point3{ int(g() & 1), 1, 2 };
+        std::vector<point3> w;
+        auto bad = [](const point3& x) { return x.x != 0; };
+        probe p;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            w = v;
+            state.ResumeTiming();
+            if constexpr (Kind == partitioning::buffered)
+                benchmark::DoNotOptimize(eop::partition_stable(w.begin(), w.end(), bad));
+            else if constexpr (Kind == partitioning::in_place)
+                benchmark::DoNotOptimize(eop::partition_stable_n(w.begin(), std::ptrdiff_t(n), bad));
+            else
+                benchmark::DoNotOptimize(std::stable_partition(w.begin(), w.end(),
+                    [&](const point3& x) { return !bad(x); }));
+        }
+        state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(n * sizeof(point3)));
+        p.report(state);
+    }
+} // namespace eop_bench
+
+using namespace eop_bench;
+
+BENCHMARK_TEMPLATE(power_unary_linear, std::uint64_t)->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(power_unary_composable, std::uint64_t)->RangeMultiplier(1 << 10)->Range(1 << 4, std::int64_t(1) << 40);
+BENCHMARK_TEMPLATE(power_unary_instrumented, std::uint64_t, false)->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(power_unary_instrumented, std::uint64_t, true)->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(orbit_distance, std::uint32_t)->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(orbit_distance, std::uint64_t)->RangeMultiplier(16)->Range(1 << 4, 1 << 24);
+BENCHMARK_TEMPLATE(orbit_distance_checkpointed, std::uint64_t)->RangeMultiplier(16)->Range(1 << 16, 1 << 24);
+BENCHMARK_TEMPLATE(orbit_structure_floyd, std::uint64_t)->RangeMultiplier(64)->Range(1 << 8, 1 << 26);
+BENCHMARK_TEMPLATE(orbit_structure_brent, std::uint64_t)->RangeMultiplier(64)->Range(1 << 8, 1 << 26);
+BENCHMARK_TEMPLATE(orbit_view_reduce, std::uint64_t)->RangeMultiplier(64)->Range(1 << 8, 1 << 26);
+BENCHMARK(power_unary_tabulated)->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK(power_unary_jump_table)->RangeMultiplier(16)->Range(1 << 4, 1 << 20);
+BENCHMARK(tabulated_analyze)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(euclidean_norm_n, float, eop::summation::naive)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(euclidean_norm_n, double, eop::summation::naive)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(euclidean_norm_n, double, eop::summation::compensated)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(euclidean_norm_n_scalar, double)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(point_norms, float, eop::norm_kernel::fused)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms, float, eop::norm_kernel::scaled)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms, float, eop::norm_kernel::widened)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms, float, eop::norm_kernel::approximate)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms_hypot, float)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms, double, eop::norm_kernel::fused)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms, double, eop::norm_kernel::scaled)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms, double, eop::norm_kernel::widened)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms, double, eop::norm_kernel::approximate)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(point_norms_hypot, double)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(euclidean_distances_soa, float)->RangeMultiplier(16)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(euclidean_distances_soa, double)->RangeMultiplier(16)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(lexicographical_equal, int)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(lexicographical_equal, double)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(lexicographical_equal, std::string)->RangeMultiplier(16)->Range(1 << 6, 1 << 16);
+BENCHMARK_TEMPLATE(construct_destruct_range, int)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(construct_destruct_range, point3)->RangeMultiplier(16)->Range(1 << 6, 1 << 22);
+BENCHMARK_TEMPLATE(construct_destruct_range, std::string)->RangeMultiplier(16)->Range(1 << 6, 1 << 16);
+BENCHMARK(ptr_construct_heap);
+BENCHMARK(ptr_construct_arena);
+BENCHMARK(ptr_construct_pool);
+BENCHMARK(handoff_unique_ptr);
+BENCHMARK(handoff_linear_slab);
+BENCHMARK_TEMPLATE(hash_set_insert_find, eop::flat_set<std::uint64_t>)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(hash_set_insert_find, std::unordered_set<std::uint64_t>)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(orbit_visited, eop::flat_set<std::uint64_t>)->RangeMultiplier(64)->Range(1 << 8, 1 << 26);
+BENCHMARK_TEMPLATE(orbit_visited, std::unordered_set<std::uint64_t>)->RangeMultiplier(64)->Range(1 << 8, 1 << 26);
+BENCHMARK_TEMPLATE(power_unary_table, 1, true)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(power_unary_table, 16, false)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(power_unary_table, 8, true)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(power_unary_table, 16, true)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(orbit_distances_table, 1, true)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(orbit_distances_table, 16, false)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(orbit_distances_table, 8, true)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(orbit_distances_table, 16, true)->Arg(16)->Arg(26);
+BENCHMARK_TEMPLATE(compose_affine_chain, chain::erased)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_affine_chain, chain::composed)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_affine_chain, chain::fused)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(relocate_buffer, std::unique_ptr<int>, false)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(relocate_buffer, std::unique_ptr<int>, true)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(relocate_buffer, opaque_handle, false)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(relocate_buffer, opaque_handle, true)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(reduce_doubles, fold::accumulate)->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(reduce_doubles, fold::unrolled)->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(reduce_doubles, fold::balanced)->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(reduce_doubles, fold::parallel)->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(scan_integers, fold::accumulate)->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(scan_integers, fold::unrolled)->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(scan_integers, fold::parallel)->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(rotate_integers, rotation::cycles)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 22 }, { 0, 64 } });
+BENCHMARK_TEMPLATE(rotate_integers, rotation::reversals)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 22 }, { 0, 64 } });
+BENCHMARK_TEMPLATE(rotate_integers, rotation::block_swaps)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 22 }, { 0, 64 } });
+BENCHMARK_TEMPLATE(rotate_integers, rotation::buffer)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 22 }, { 0, 64 } });
+BENCHMARK_TEMPLATE(rotate_integers, rotation::dispatched)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 22 }, { 0, 64 } });
+BENCHMARK_TEMPLATE(rotate_integers, rotation::standard)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 22 }, { 0, 64 } });
+BENCHMARK_TEMPLATE(stable_partition_records, partitioning::buffered)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(stable_partition_records, partitioning::in_place)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(stable_partition_records, partitioning::standard)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_MAIN();
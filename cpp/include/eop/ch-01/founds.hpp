@@ -33,6 +33,22 @@ namespace eop
         }
     };
 
+    /**
+     * @brief Relocation semantics: move construction into raw
+     * storage x from y, ending the lifetime of y
+     * 
+     * @tparam _Tp A move constructible type
+     */
+    template< move_constructible _Tp >
+    struct relocator
+    {
+        void operator()(_Tp& x, _Tp& y) const
+            noexcept(noexcept(eop::relocate_at(std::addressof(y), std::addressof(x))))
+        {
+            eop::relocate_at(std::addressof(y), std::addressof(x));
+        }
+    };
+
     /**
      * @brief Copy and move assignment semantics
      * 
@@ -61,6 +77,36 @@ namespace eop
         }
     };
 
+    /**
+     * @brief Triple as a heterogeneous regular type,
+     * with members m0, m1 and m2
+     * 
+     * @tparam _Tp0 A regular type
+     * @tparam _Tp1 Another regular type
+     * @tparam _Tp2 Another regular type
+     */
+    template< regular _Tp0, regular _Tp1, regular _Tp2 >
+    struct triple
+    {
+        _Tp0 m0;
+        _Tp1 m1;
+        _Tp2 m2;
+
+        friend
+        constexpr
+        bool operator==(const triple& x, const triple& y) noexcept
+        {
+            return x.m0 == y.m0 && x.m1 == y.m1 && x.m2 == y.m2;
+        }
+
+        friend
+        constexpr
+        bool operator!=(const triple& x, const triple& y) noexcept
+        {
+            return !(x == y);
+        }
+    };
+
     /**
      * @brief Variadic template struct for equality comparison
      * as an n-ary homogeneous predicate
@@ -113,12 +159,117 @@ namespace eop
     struct equal<_Tp, 2>
     {
         inline
-        bool operator()(const _Tp& x, const _Tp& y) const noexcept
+        bool operator()(const _Tp& x, const _Tp& y) const noexcept(noexcept(bool(x == y)))
         {
             static_assert(eop::is_equality_comparable_v<_Tp>);
             return x == y;
         }
     };
+
+    /**
+     * @brief Determines whether $[f_0, l_0)$ and the range of
+     * the same length starting at $f_1$ are elementwise equal
+     * 
+     * Contiguous ranges of the same trivially equality
+     * comparable type are compared with memcmp, which is
+     * vectorized and exits at the first difference; other ranges
+     * are compared one element at a time with $\func{equal}$.
+     * 
+     * @tparam I0 A forward iterator type
+     * @tparam I1 A forward iterator type
+     * @param f0 The first position of the first range
+     * @param l0 Past the last position of the first range
+     * @param f1 The first position of the second range
+     * @return bool 
+     */
+    template< forward_iterator I0, forward_iterator I1 >
+    bool lexicographical_equal(I0 f0, I0 l0, I1 f1)
+        noexcept(noexcept(bool(*f0 == *f1)) && noexcept(++f0) && noexcept(++f1))
+    {
+        using T0 = std::remove_cv_t<eop::iterator_value_type<I0>>;
+        using T1 = std::remove_cv_t<eop::iterator_value_type<I1>>;
+        static_assert(eop::is_equality_comparable_v<T0>);
+        if constexpr (std::is_pointer_v<I0> && std::is_pointer_v<I1>
+            && std::is_same_v<T0, T1>
+            && eop::is_trivially_equality_comparable_v<T0>)
+        {
+            std::size_t n = std::size_t(l0 - f0);
+            return n == 0 || std::memcmp(f0, f1, n * sizeof(T0)) == 0;
+        }
+        else if constexpr (std::is_same_v<T0, T1>)
+        {
+            eop::equal<T0, 2> eq;
+            for (; f0 != l0; ++f0, ++f1)
+                if (!eq(*f0, *f1)) return false;
+            return true;
+        }
+        else
+        {
+            for (; f0 != l0; ++f0, ++f1)
+                if (!(*f0 == *f1)) return false;
+            return true;
+        }
+    }
+
+    /**
+     * @brief Determines whether two bounded ranges have equal
+     * lengths and are elementwise equal
+     * 
+     * @tparam I0 A forward iterator type
+     * @tparam I1 A forward iterator type
+     * @param f0 The first position of the first range
+     * @param l0 Past the last position of the first range
+     * @param f1 The first position of the second range
+     * @param l1 Past the last position of the second range
+     * @return bool 
+     */
+    template< forward_iterator I0, forward_iterator I1 >
+    bool lexicographical_equal(I0 f0, I0 l0, I1 f1, I1 l1)
+        noexcept(noexcept(eop::lexicographical_equal(f0, l0, f1)))
+    {
+        if (std::distance(f0, l0) != std::distance(f1, l1)) return false;
+        return eop::lexicographical_equal(f0, l0, f1);
+    }
+
+    /**
+     * @brief Determines whether $[f_0, l_0)$ equals each range
+     * of the same length starting at one of $fs$
+     * 
+     * @tparam I0 A forward iterator type
+     * @tparam Is Forward iterator types
+     * @param f0 The first position of the first range
+     * @param l0 Past the last position of the first range
+     * @param fs The first positions of the other ranges
+     * @return bool 
+     */
+    template< forward_iterator I0, forward_iterator... Is >
+    bool lexicographical_equal_all(I0 f0, I0 l0, Is... fs)
+        noexcept((noexcept(eop::lexicographical_equal(f0, l0, fs)) && ...))
+    {
+        return (eop::lexicographical_equal(f0, l0, fs) && ...);
+    }
+
+    /**
+     * @brief Determines whether two containers have equal
+     * sizes and are elementwise equal, comparing contiguous
+     * containers through their data()
+     * 
+     * @tparam C0 A container type
+     * @tparam C1 A container type
+     * @param x A container
+     * @param y Another container
+     * @return bool 
+     */
+    template< container C0, container C1 >
+    auto lexicographical_equal(const C0& x, const C1& y)
+        noexcept(noexcept(eop::lexicographical_equal(eop::range_first(x), eop::range_last(x),
+            eop::range_first(y))))
+        -> decltype(std::begin(x), std::begin(y), bool())
+    {
+        if (std::size(x) != std::size(y)) return false;
+        return eop::lexicographical_equal(eop::range_first(x), eop::range_last(x),
+            eop::range_first(y));
+    }
 } // namespace eop
 
 #endif // !EOP_CH1_FOUNDATIONS_H
\ No newline at end of file
@@ -0,0 +1,577 @@
+#ifndef EOP_CHECKPOINTED_ORBITS_HPP
+#define EOP_CHECKPOINTED_ORBITS_HPP
+
+#include "transorbs.hpp"
+
+namespace eop
+{
+    /**
+     * @brief The walk a checkpoint belongs to, and how far it
+     * has got
+     *
+     */
+    enum class orbit_phase : std::uint32_t
+    {
+        /** orbit_distance: fast walks from origin to target */
+        distance = 1,
+        /** Brent, first walk: fast runs until it meets slow */
+        brent_cycle = 2,
+        /** Brent: fast is moved count steps ahead of origin */
+        brent_advance = 3,
+        /** Brent, second walk: slow and fast move in step */
+        brent_handle = 4,
+        /** The walk has finished and holds its result */
+        done = 5
+    };
+
+    /**
+     * @brief Complete state of a resumable orbit walk
+     *
+     * A walk is advanced in bounded slices by eop::orbit_advance,
+     * and between two slices its state is this plain value, so
+     * that it can be persisted and the walk later resumed with
+     * identical results. Which members are meaningful depends on
+     * the phase:
+     * - distance: fast is $f^{count}(origin)$;
+     * - brent_cycle: slow and fast as in Brent's algorithm, with
+     *   count steps taken since slow was last moved (none yet
+     *   when steps is zero);
+     * - brent_advance: the cycle size in power, and fast is
+     *   $f^{count}(origin)$;
+     * - brent_handle: the cycle size in power, slow is
+     *   $f^{count}(origin)$ and fast is $f^{power}(slow)$;
+     * - done: the result, a distance in count, or a shape
+     *   $(count, power - 1, slow)$.
+     *
+     * steps counts every application of f, for progress reports
+     * and checkpoint intervals.
+     *
+     * @tparam F A type for transformation
+     */
+    template< transformation F >
+    struct orbit_checkpoint
+    {
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+
+        eop::orbit_phase phase;
+        eop::orbit_phase start;
+        D origin;
+        D target;
+        D slow;
+        D fast;
+        N power;
+        N count;
+        std::uint64_t steps;
+    };
+
+    /**
+     * @brief Starts the walk of eop::orbit_distance from x to y
+     *
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param y Another element of the domain of f
+     * @return eop::orbit_checkpoint<F>
+     */
+    template< transformation F >
+    constexpr
+    eop::orbit_checkpoint<F> orbit_distance_walk(const eop::domain<F>& x,
+        const eop::domain<F>& y) noexcept
+    {
+        using N = eop::distance_type<F>;
+        return { eop::orbit_phase::distance, eop::orbit_phase::distance,
+                 x, y, x, x, N(0), N(0), 0 };
+    }
+
+    /**
+     * @brief Starts the walk of
+     * eop::orbit_structure_brent_nonterminating_orbit from x
+     *
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @return eop::orbit_checkpoint<F>
+     */
+    template< transformation F >
+    constexpr
+    eop::orbit_checkpoint<F> orbit_structure_walk(const eop::domain<F>& x) noexcept
+    {
+        using N = eop::distance_type<F>;
+        return { eop::orbit_phase::brent_cycle, eop::orbit_phase::brent_cycle,
+                 x, x, x, x, N(1), N(0), 0 };
+    }
+
+    /**
+     * @brief Advances a walk by at most budget iterations, of one
+     * application of f each but in Brent's second walk, which
+     * applies it twice
+     *
+     * Each phase runs as a tight loop with one extra comparison
+     * against the budget, so slicing a walk costs next to nothing
+     * when the budget is large.
+     *
+     * Precondition: s was started on f, and, for a distance walk,
+     * its target is reachable from its origin
+     *
+     * @tparam F A type for transformation
+     * @param s The state of the walk
+     * @param f Some transformation
+     * @param budget The largest number of applications of f
+     * @return bool Whether the walk is done
+     */
+    template< transformation F >
+    constexpr
+    bool orbit_advance(eop::orbit_checkpoint<F>& s, F f, std::uint64_t budget)
+    {
+        using N = eop::distance_type<F>;
+        using D = eop::domain<F>;
+        // Each loop runs on copies in registers: stores through s
+        // could alias the state of f and would pin them to memory.
+        std::uint64_t i = 0;
+        switch (s.phase)
+        {
+        case eop::orbit_phase::distance:
+        {
+            D x = s.fast;
+            const D y = s.target;
+            std::uint64_t r = budget;
+            while (r != 0 && x != y)
+            {
+                x = f(x);
+                --r;
+            }
+            i = budget - r;
+            s.fast = x;
+            s.count = N(s.count + N(i));
+            s.steps += i;
+            if (x != y) return false;
+            s.phase = eop::orbit_phase::done;
+            return true;
+        }
+        case eop::orbit_phase::brent_cycle:
+        {
+            D slow = s.slow;
+            D fast = s.fast;
+            N power = s.power;
+            N c = s.count;
+            if (s.steps == 0 && budget != 0)
+            {
+                fast = f(fast);
+                c = N(1);
+                ++i;
+            }
+            while (i != budget && fast != slow)
+            {
+                if (power == c)
+                {
+                    slow = fast;
+                    power = N(power + power);
+                    c = N(0);
+                }
+                fast = f(fast);
+                c = N(c + N(1));
+                ++i;
+            }
+            s.steps += i;
+            s.slow = slow;
+            s.fast = fast;
+            s.power = power;
+            s.count = c;
+            if (fast != slow) return false;
+            s.power = c;
+            s.count = N(0);
+            s.fast = s.origin;
+            s.phase = eop::orbit_phase::brent_advance;
+            return eop::orbit_advance(s, f, budget - i);
+        }
+        case eop::orbit_phase::brent_advance:
+        {
+            D fast = s.fast;
+            const N c = s.power;
+            N k = s.count;
+            while (i != budget && k != c)
+            {
+                fast = f(fast);
+                k = N(k + N(1));
+                ++i;
+            }
+            s.steps += i;
+            s.fast = fast;
+            s.count = k;
+            if (k != c) return false;
+            s.count = N(0);
+            s.slow = s.origin;
+            s.phase = eop::orbit_phase::brent_handle;
+            return eop::orbit_advance(s, f, budget - i);
+        }
+        case eop::orbit_phase::brent_handle:
+        {
+            D slow = s.slow;
+            D fast = s.fast;
+            while (i != budget && fast != slow)
+            {
+                slow = f(slow);
+                fast = f(fast);
+                ++i;
+            }
+            s.slow = slow;
+            s.fast = fast;
+            s.count = N(s.count + N(i));
+            s.steps += 2 * i;
+            if (fast != slow) return false;
+            s.phase = eop::orbit_phase::done;
+            return true;
+        }
+        default:
+            return true;
+        }
+    }
+
+    /**
+     * @brief A checkpoint policy decides how often the state of a
+     * walk is persisted, persists it, and restores it on restart
+     *
+     * - stride(): the number of applications of f between two
+     *   calls to due(), i.e. the slice given to orbit_advance;
+     * - due(s): whether s, at the end of a slice, is to be saved;
+     * - save(s): persists s;
+     * - restore(s): replaces s by the latest persisted state of
+     *   the same walk, if there is one, and tells whether it did.
+     *
+     * @tparam C A checkpoint policy type
+     * @tparam S A walk state type
+     */
+    template< class C, class S >
+    concept checkpoint_policy = requires(C& c, S& s, const S& cs)
+    {
+        { c.stride() } -> std::convertible_to<std::uint64_t>;
+        { c.due(cs) } -> std::convertible_to<bool>;
+        c.save(cs);
+        { c.restore(s) } -> std::convertible_to<bool>;
+    };
+
+    /**
+     * @brief The policy that never checkpoints, which runs a walk
+     * as a single slice
+     *
+     */
+    struct no_checkpoint
+    {
+        constexpr std::uint64_t stride() const noexcept
+        {
+            return ~std::uint64_t(0);
+        }
+
+        template< class S >
+        constexpr bool due(const S&) const noexcept
+        {
+            return false;
+        }
+
+        template< class S >
+        constexpr void save(const S&) const noexcept {}
+
+        template< class S >
+        constexpr bool restore(S&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    /**
+     * @brief Persists walk states to a compact binary file,
+     * every so many steps or so much time, whichever comes first
+     *
+     * A state is written to a temporary file next to the
+     * checkpoint, flushed to disk, and renamed over the
+     * checkpoint, so that a crash at any point leaves either the
+     * previous or the new checkpoint intact. The file holds a
+     * header (magic, version, phase and the sizes of the domain
+     * and distance types), the state, and an FNV-1a checksum;
+     * $\func{restore}$ ignores a file that does not match all of
+     * them or that belongs to a walk with another origin, target
+     * or algorithm.
+     *
+     * The clock is only read at the end of a slice of
+     * $\func{stride}$ steps; lower the stride when single
+     * applications of f are slow compared to the period.
+     *
+     * Precondition: the domain and distance types are trivially
+     * copyable, and the walk is resumed on the same f
+     */
+    class file_checkpoint
+    {
+    private:
+        static constexpr char magic[8] = { 'E', 'O', 'P', 'C', 'K', 'P', 'T', '\0' };
+        static constexpr std::uint32_t version = 1;
+
+        std::filesystem::path _path;
+        std::uint64_t _every;
+        std::chrono::steady_clock::duration _period;
+        std::uint64_t _stride;
+        std::uint64_t _last_steps = 0;
+        std::chrono::steady_clock::time_point _last_time = std::chrono::steady_clock::now();
+        std::uint64_t _saves = 0;
+
+        static std::uint64_t checksum(const unsigned char* p, std::size_t n) noexcept
+        {
+            std::uint64_t h = 14695981039346656037ull;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                h ^= p[i];
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        template< class _Tp >
+        static unsigned char* put(unsigned char* p, const _Tp& x) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<_Tp>);
+            std::memcpy(p, &x, sizeof(_Tp));
+            return p + sizeof(_Tp);
+        }
+
+        template< class _Tp >
+        static const unsigned char* get(const unsigned char* p, _Tp& x) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<_Tp>);
+            std::memcpy(&x, p, sizeof(_Tp));
+            return p + sizeof(_Tp);
+        }
+
+        /**
+         * @brief Size of a record: magic, version, start and
+         * current phase, type sizes, four domain elements, two
+         * distances, steps and checksum
+         *
+         */
+        template< class D, class N >
+        static constexpr std::size_t record_size() noexcept
+        {
+            return sizeof(magic) + 5 * sizeof(std::uint32_t)
+                + 4 * sizeof(D) + 2 * sizeof(N) + 2 * sizeof(std::uint64_t);
+        }
+
+        template< class D, class N >
+        using record = std::array<unsigned char, eop::file_checkpoint::record_size<D, N>()>;
+
+        [[noreturn]] void fail(const char* what) const
+        {
+            throw std::filesystem::filesystem_error(what, _path,
+                std::error_code(errno, std::generic_category()));
+        }
+
+        void write(const unsigned char* b, std::size_t n)
+        {
+            std::filesystem::path tmp = _path;
+            tmp += ".tmp";
+            std::FILE* file = std::fopen(tmp.c_str(), "wb");
+            if (!file) fail("cannot create checkpoint");
+            bool ok = std::fwrite(b, 1, n, file) == n
+                && std::fflush(file) == 0;
+        #if defined(__unix__) || defined(__APPLE__)
+            ok = ok && ::fsync(::fileno(file)) == 0;
+        #endif
+            ok = std::fclose(file) == 0 && ok;
+            if (!ok) fail("cannot write checkpoint");
+            std::filesystem::rename(tmp, _path);
+        }
+
+    public:
+        /**
+         * @brief Checkpoints to path every steps applications of f
+         * or every period, whichever comes first
+         *
+         * @param path The checkpoint file
+         * @param steps The largest number of steps between saves
+         * @param period The longest time between saves
+         * @param stride The number of steps between clock reads
+         */
+        explicit file_checkpoint(std::filesystem::path path,
+            std::uint64_t steps = ~std::uint64_t(0),
+            std::chrono::steady_clock::duration period = std::chrono::steady_clock::duration::max(),
+            std::uint64_t stride = std::uint64_t(1) << 16)
+            : _path(std::move(path)), _every(steps), _period(period),
+              _stride(std::max<std::uint64_t>(std::min(stride, steps), 1)) {}
+
+        const std::filesystem::path& path() const noexcept
+        {
+            return _path;
+        }
+
+        std::uint64_t stride() const noexcept
+        {
+            return _stride;
+        }
+
+        /**
+         * @brief The number of checkpoints written so far
+         *
+         * @return std::uint64_t
+         */
+        std::uint64_t saves() const noexcept
+        {
+            return _saves;
+        }
+
+        template< transformation F >
+        bool due(const eop::orbit_checkpoint<F>& s) const noexcept
+        {
+            return s.steps - _last_steps >= _every
+                || std::chrono::steady_clock::now() - _last_time >= _period;
+        }
+
+        template< transformation F >
+        void save(const eop::orbit_checkpoint<F>& s)
+        {
+            using D = eop::domain<F>;
+            using N = eop::distance_type<F>;
+            eop::file_checkpoint::record<D, N> b;
+            std::memcpy(b.data(), magic, sizeof(magic));
+            unsigned char* p = b.data() + sizeof(magic);
+            p = eop::file_checkpoint::put(p, version);
+            p = eop::file_checkpoint::put(p, std::uint32_t(s.start));
+            p = eop::file_checkpoint::put(p, std::uint32_t(s.phase));
+            p = eop::file_checkpoint::put(p, std::uint32_t(sizeof(D)));
+            p = eop::file_checkpoint::put(p, std::uint32_t(sizeof(N)));
+            p = eop::file_checkpoint::put(p, s.origin);
+            p = eop::file_checkpoint::put(p, s.target);
+            p = eop::file_checkpoint::put(p, s.slow);
+            p = eop::file_checkpoint::put(p, s.fast);
+            p = eop::file_checkpoint::put(p, s.power);
+            p = eop::file_checkpoint::put(p, s.count);
+            p = eop::file_checkpoint::put(p, s.steps);
+            eop::file_checkpoint::put(p,
+                eop::file_checkpoint::checksum(b.data(), std::size_t(p - b.data())));
+            write(b.data(), b.size());
+            _last_steps = s.steps;
+            _last_time = std::chrono::steady_clock::now();
+            ++_saves;
+        }
+
+        template< transformation F >
+        bool restore(eop::orbit_checkpoint<F>& s)
+        {
+            using D = eop::domain<F>;
+            using N = eop::distance_type<F>;
+            std::FILE* file = std::fopen(_path.c_str(), "rb");
+            if (!file) return false;
+            eop::file_checkpoint::record<D, N> b;
+            unsigned char extra;
+            bool read = std::fread(b.data(), 1, b.size(), file) == b.size()
+                && std::fread(&extra, 1, 1, file) == 0;
+            std::fclose(file);
+            if (!read || std::memcmp(b.data(), magic, sizeof(magic)) != 0) return false;
+
+            std::uint32_t v, start, phase, sd, sn;
+            D origin, target, slow, fast;
+            N power, count;
+            std::uint64_t steps, sum;
+            const unsigned char* p = b.data() + sizeof(magic);
+            p = eop::file_checkpoint::get(p, v);
+            p = eop::file_checkpoint::get(p, start);
+            p = eop::file_checkpoint::get(p, phase);
+            p = eop::file_checkpoint::get(p, sd);
+            p = eop::file_checkpoint::get(p, sn);
+            p = eop::file_checkpoint::get(p, origin);
+            p = eop::file_checkpoint::get(p, target);
+            p = eop::file_checkpoint::get(p, slow);
+            p = eop::file_checkpoint::get(p, fast);
+            p = eop::file_checkpoint::get(p, power);
+            p = eop::file_checkpoint::get(p, count);
+            p = eop::file_checkpoint::get(p, steps);
+            std::size_t body = std::size_t(p - b.data());
+            eop::file_checkpoint::get(p, sum);
+            if (v != version || sd != sizeof(D) || sn != sizeof(N)
+                || sum != eop::file_checkpoint::checksum(b.data(), body)
+                || start != std::uint32_t(s.start)
+                || phase < std::uint32_t(eop::orbit_phase::distance)
+                || phase > std::uint32_t(eop::orbit_phase::done)
+                || origin != s.origin || target != s.target) return false;
+
+            s.phase = eop::orbit_phase(phase);
+            s.slow = slow;
+            s.fast = fast;
+            s.power = power;
+            s.count = count;
+            s.steps = steps;
+            _last_steps = steps;
+            _last_time = std::chrono::steady_clock::now();
+            return true;
+        }
+    };
+
+    /**
+     * @brief Runs a walk to the end in slices, resuming it from
+     * the policy's checkpoint if there is one and checkpointing
+     * it when due and once done
+     *
+     * @tparam F A type for transformation
+     * @tparam C A checkpoint policy type
+     * @param s The initial state of the walk
+     * @param f Some transformation
+     * @param checkpoint The checkpoint policy
+     * @return eop::orbit_checkpoint<F> The final state
+     */
+    template< transformation F, checkpoint_policy<eop::orbit_checkpoint<F>> C >
+    eop::orbit_checkpoint<F> orbit_walk(eop::orbit_checkpoint<F> s, F f, C&& checkpoint)
+    {
+        checkpoint.restore(s);
+        if (s.phase == eop::orbit_phase::done) return s;
+        std::uint64_t stride = checkpoint.stride();
+        while (!eop::orbit_advance(s, f, stride))
+            if (checkpoint.due(s)) checkpoint.save(s);
+        checkpoint.save(s);
+        return s;
+    }
+
+    /**
+     * @brief Computes the minimal number of steps from $x$ to
+     * $y$, checkpointing the walk under a policy
+     *
+     * Restarted with the same arguments after an interruption,
+     * the walk resumes from the latest checkpoint and returns
+     * the same distance as an uninterrupted one.
+     *
+     * Precondition: $y$ is reachable from $x$ under $f$
+     *
+     * @tparam F A type for transformation
+     * @tparam C A checkpoint policy type
+     * @param x An element of the domain of f
+     * @param y Another element of the domain of f
+     * @param f Some transformation
+     * @param checkpoint The checkpoint policy
+     * @return eop::distance_type<F>
+     */
+    template< transformation F, checkpoint_policy<eop::orbit_checkpoint<F>> C >
+    eop::distance_type<F> orbit_distance(const eop::domain<F>& x,
+        const eop::domain<F>& y, F f, C&& checkpoint)
+    {
+        return eop::orbit_walk(eop::orbit_distance_walk<F>(x, y), f, checkpoint).count;
+    }
+
+    /**
+     * @brief Computes the shape of a nonterminating orbit by
+     * Brent's algorithm, checkpointing the walk under a policy
+     *
+     * Precondition: the orbit of $x$ under $f$ is nonterminating
+     *
+     * @tparam F A type for transformation
+     * @tparam C A checkpoint policy type
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @param checkpoint The checkpoint policy
+     * @return eop::orbit_shape<F>
+     */
+    template< transformation F, checkpoint_policy<eop::orbit_checkpoint<F>> C >
+    eop::orbit_shape<F> orbit_structure_brent_nonterminating_orbit(
+        const eop::domain<F>& x, F f, C&& checkpoint)
+    {
+        using N = eop::distance_type<F>;
+        eop::orbit_checkpoint<F> s = eop::orbit_walk(
+            eop::orbit_structure_walk<F>(x), f, checkpoint);
+        return { s.count, N(s.power - N(1)), s.slow };
+    }
+} // namespace eop
+
+#endif // !EOP_CHECKPOINTED_ORBITS_HPP
@@ -0,0 +1,240 @@
+#ifndef EOP_COMPOSITION_HPP
+#define EOP_COMPOSITION_HPP
+
+#include "transorbs.hpp"
+
+namespace eop
+{
+    /**
+     * @brief The composition $f \circ g$ of two transformations
+     * on the same domain, as a type visible to the compiler
+     *
+     * Unlike a lambda wrapping both calls or a std::function, the
+     * composition carries the traits of its parts, so it is
+     * itself a transformation for eop::power_unary and
+     * eop::orbit_distance, and both calls inline into the loop
+     * that applies it.
+     *
+     * @tparam F A type for transformation, applied last
+     * @tparam G A type for transformation, applied first
+     */
+    template< transformation F, transformation G >
+    struct composed
+    {
+        static_assert(std::is_same_v<eop::domain<F>, eop::domain<G>>);
+
+        [[no_unique_address]] F f;
+        [[no_unique_address]] G g;
+
+        constexpr eop::domain<G> operator()(const eop::domain<G>& x)
+        {
+            return f(g(x));
+        }
+
+        constexpr eop::domain<G> operator()(const eop::domain<G>& x) const
+            requires std::invocable<const F&, eop::domain<G>>
+                && std::invocable<const G&, eop::domain<G>>
+        {
+            return f(g(x));
+        }
+    };
+
+    template< transformation F, transformation G >
+    struct input<eop::composed<F, G>, 0> : eop::input<G, 0> {};
+
+    template< transformation F, transformation G >
+    struct output<eop::composed<F, G>> : eop::output<F> {};
+
+    template< transformation F, transformation G >
+    struct distance<eop::composed<F, G>> : eop::distance<G> {};
+
+    /**
+     * @brief The iterate $f^K$ of a transformation for a constant
+     * K, applying f K times in straight-line code
+     *
+     * Meant for small K; eop::iterate folds $f^K$ into a single
+     * transformation instead when F has a composition law.
+     *
+     * @tparam F A type for transformation
+     * @tparam K The iterate number
+     */
+    template< transformation F, std::size_t K >
+    struct iterated
+    {
+        [[no_unique_address]] F f;
+
+        constexpr eop::domain<F> operator()(eop::domain<F> x)
+        {
+            return apply(f, x, std::make_index_sequence<K>());
+        }
+
+        constexpr eop::domain<F> operator()(eop::domain<F> x) const
+            requires std::invocable<const F&, eop::domain<F>>
+        {
+            return apply(f, x, std::make_index_sequence<K>());
+        }
+
+    private:
+        template< class H, std::size_t... I >
+        static constexpr eop::domain<F> apply(H& h, eop::domain<F> x,
+            std::index_sequence<I...>)
+        {
+            ((x = h(x), (void)I), ...);
+            return x;
+        }
+    };
+
+    template< transformation F, std::size_t K >
+    struct input<eop::iterated<F, K>, 0> : eop::input<F, 0> {};
+
+    template< transformation F, std::size_t K >
+    struct output<eop::iterated<F, K>> : eop::output<F> {};
+
+    template< transformation F, std::size_t K >
+    struct distance<eop::iterated<F, K>> : eop::distance<F> {};
+
+    /**
+     * @brief Trait for pairs of transformation types whose
+     * composition is known in closed form
+     *
+     * Specialize $\func{fusion}$ with a static $\func{fuse}(f, g)$
+     * returning a transformation equal to $f \circ g$ only when the
+     * two are exactly equal on the whole domain, e.g. not for
+     * floating-point maps that would round differently. Pairs of
+     * the same type with an eop::composition law are fused
+     * without a specialization.
+     *
+     */
+    template< class F, class G >
+    struct fusion {};
+
+    template< class F, class G, class=void >
+    struct has_fusion : std::false_type{};
+    template< class F, class G >
+    struct has_fusion<F, G,
+        typename std::enable_if<
+            true,
+            decltype(eop::fusion<F, G>::fuse(std::declval<const F&>(),
+                                              std::declval<const G&>()),
+                (void)0)>::type
+            > : std::true_type {};
+
+    template< class F, class G >
+    inline
+    constexpr
+    bool is_fusible_v = eop::has_fusion<F, G>::value
+        || (std::is_same_v<F, G> && eop::is_composable_transformation_v<F>);
+
+    /**
+     * @brief Composes transformations, $f \circ g \circ \ldots$,
+     * applying the last one first
+     *
+     * Adjacent transformations are fused into one, from the
+     * right, wherever eop::is_fusible_v allows, e.g. a chain of
+     * affine maps becomes a single affine map; the others are
+     * nested into eop::composed.
+     *
+     * @tparam F A type for transformation
+     * @tparam G Types for transformation on the same domain
+     * @param f The transformation applied last
+     * @param g The transformations applied before f
+     * @return A transformation equal to $f \circ g \circ \ldots$
+     */
+    template< transformation F, transformation... G >
+    constexpr
+    auto compose(F f, G... g)
+    {
+        if constexpr (sizeof...(G) == 0)
+            return f;
+        else
+        {
+            auto h = eop::compose(std::move(g)...);
+            using H = decltype(h);
+            if constexpr (eop::has_fusion<F, H>::value)
+                return eop::fusion<F, H>::fuse(f, h);
+            else if constexpr (eop::is_fusible_v<F, H>)
+                return eop::composition<F>::compose(f, h);
+            else
+                return eop::composed<F, H>{ std::move(f), std::move(h) };
+        }
+    }
+
+    /**
+     * @brief The iterate $f^K$ of a transformation, for a
+     * constant K
+     *
+     * A transformation with an eop::composition law is raised to
+     * the K-th power once, by eop::power_transformation; any
+     * other is unrolled by eop::iterated.
+     *
+     * @tparam K The iterate number
+     * @tparam F A type for transformation
+     * @param f Some transformation
+     * @return A transformation equal to $f^K$
+     */
+    template< std::size_t K, transformation F >
+    constexpr
+    auto iterate(F f)
+    {
+        if constexpr (eop::is_composable_transformation_v<F>)
+            return eop::power_transformation(f, K);
+        else
+            return eop::iterated<F, K>{ std::move(f) };
+    }
+
+    /**
+     * @brief The affine map $x \mapsto a x + b$ over an unsigned
+     * integral type, i.e. modulo $2^w$
+     *
+     * Composition stays exact in modular arithmetic, so affine
+     * maps declare a composition law and fuse under eop::compose.
+     *
+     * @tparam _Tp An unsigned integral type
+     */
+    template< class _Tp >
+    struct affine
+    {
+        static_assert(std::is_unsigned_v<_Tp>);
+
+        // Narrow types are promoted to unsigned, not to int
+        using U = decltype(_Tp() + 0u);
+
+        _Tp a;
+        _Tp b;
+
+        constexpr _Tp operator()(_Tp x) const noexcept
+        {
+            return _Tp(U(a) * U(x) + U(b));
+        }
+    };
+
+    template< class _Tp >
+    struct input<eop::affine<_Tp>, 0>
+    {
+        using type = _Tp;
+    };
+
+    template< class _Tp >
+    struct output<eop::affine<_Tp>>
+    {
+        using type = _Tp;
+    };
+
+    template< class _Tp >
+    struct composition<eop::affine<_Tp>>
+    {
+        static constexpr eop::affine<_Tp> compose(const eop::affine<_Tp>& f,
+            const eop::affine<_Tp>& g) noexcept
+        {
+            using U = typename eop::affine<_Tp>::U;
+            return { _Tp(U(f.a) * U(g.a)), _Tp(U(f.a) * U(g.b) + U(f.b)) };
+        }
+
+        static constexpr eop::affine<_Tp> identity(const eop::affine<_Tp>&) noexcept
+        {
+            return { _Tp(1), _Tp(0) };
+        }
+    };
+} // namespace eop
+
+#endif // !EOP_COMPOSITION_HPP
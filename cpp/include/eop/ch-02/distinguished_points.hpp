@@ -0,0 +1,240 @@
+#ifndef EOP_DISTINGUISHED_POINTS_HPP
+#define EOP_DISTINGUISHED_POINTS_HPP
+
+#include "transorbs.hpp"
+#include "../executor.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Fixed-capacity, insert-only, lock-free table of
+     * distinguished points, mapping each point to the start and
+     * length of the trail that reached it
+     * 
+     * Slots are claimed with a compare-and-swap on their state
+     * and published with a release store, so readers never see a
+     * partially written entry. A point that finds no free slot
+     * within the probe limit is dropped, which costs a little
+     * detection latency but never correctness.
+     * 
+     * @tparam _Tp A regular type
+     * @tparam H A hash function type for _Tp
+     */
+    template< regular _Tp, class H = std::hash<_Tp> >
+    class distinguished_point_table
+    {
+    private:
+        enum : std::uint8_t { empty = 0, writing = 1, full = 2 };
+
+        struct slot
+        {
+            std::atomic<std::uint8_t> state{empty};
+            _Tp point;
+            _Tp start;
+            std::uint64_t length;
+        };
+
+        std::unique_ptr<slot[]> _slots;
+        std::size_t _mask;
+        H _hash;
+
+    public:
+        static constexpr std::size_t max_probes = 64;
+
+        /**
+         * @brief Result of an insertion: whether the point was
+         * already present, and if so the trail that reached it
+         * 
+         */
+        struct entry
+        {
+            bool found;
+            _Tp start;
+            std::uint64_t length;
+        };
+
+        /**
+         * @brief Creates an empty table
+         * 
+         * @param capacity The minimum number of slots, rounded up
+         * to a power of two
+         * @param hash The hash function
+         */
+        explicit distinguished_point_table(std::size_t capacity, H hash = H())
+            : _hash(hash)
+        {
+            std::size_t n = 1;
+            while (n < capacity) n = n + n;
+            _slots.reset(new slot[n]);
+            _mask = n - 1;
+        }
+
+        /**
+         * @brief Inserts a point reached from start after length
+         * steps, or reports the trail already stored for it
+         * 
+         * @param point A distinguished point
+         * @param start The start of the trail
+         * @param length The trail length
+         * @return entry 
+         */
+        entry insert(const _Tp& point, const _Tp& start, std::uint64_t length) noexcept
+        {
+            std::size_t h = std::size_t(_hash(point));
+            for (std::size_t k = 0; k < max_probes; ++k)
+            {
+                slot& s = _slots[(h + k) & _mask];
+                std::uint8_t state = s.state.load(std::memory_order_acquire);
+                if (state == empty)
+                {
+                    if (s.state.compare_exchange_strong(state, writing,
+                        std::memory_order_acquire))
+                    {
+                        s.point = point;
+                        s.start = start;
+                        s.length = length;
+                        s.state.store(full, std::memory_order_release);
+                        return { false, start, length };
+                    }
+                }
+                while (state == writing)
+                {
+                    std::this_thread::yield();
+                    state = s.state.load(std::memory_order_acquire);
+                }
+                if (s.point == point) return { true, s.start, s.length };
+            }
+            return { false, start, length };
+        }
+    };
+
+    /**
+     * @brief Tuning for a distinguished-point collision search
+     * 
+     * capacity bounds the table, max_trail abandons walks caught
+     * in a cycle without distinguished points, max_walks bounds
+     * the whole search, and chunk is the number of walks handed
+     * to a thread at a time.
+     * 
+     */
+    struct distinguished_point_options
+    {
+        std::size_t capacity = std::size_t(1) << 20;
+        std::uint64_t max_trail = std::uint64_t(1) << 32;
+        std::size_t max_walks = std::size_t(1) << 32;
+        std::size_t chunk = 1;
+    };
+
+    /**
+     * @brief Given two trails known to end at the same point,
+     * finds where they merge
+     * 
+     * Returns $(a, b, f(a))$ with $a \neq b$ and $f(a) = f(b)$,
+     * or nothing when one start lies on the other's trail.
+     * 
+     * @tparam F A type for transformation
+     * @param a The start of one trail
+     * @param la Its length
+     * @param b The start of the other trail
+     * @param lb Its length
+     * @param f Some transformation
+     * @return std::optional<eop::triple<...>> 
+     */
+    template< transformation F >
+    std::optional<eop::triple<eop::domain<F>, eop::domain<F>, eop::domain<F>>>
+    merge_trails(eop::domain<F> a, std::uint64_t la, eop::domain<F> b,
+        std::uint64_t lb, F f) noexcept
+    {
+        for (; la > lb; --la) a = f(a);
+        for (; lb > la; --lb) b = f(b);
+        if (a == b) return std::nullopt;
+        while (true)
+        {
+            eop::domain<F> fa = f(a);
+            eop::domain<F> fb = f(b);
+            if (fa == fb) return eop::triple<eop::domain<F>, eop::domain<F>,
+                eop::domain<F>>{ a, b, fa };
+            a = fa;
+            b = fb;
+        }
+    }
+
+    /**
+     * @brief Searches for a collision of $f$, i.e. elements
+     * $a \neq b$ with $f(a) = f(b)$, by van Oorschot and Wiener's
+     * parallel distinguished-point method
+     * 
+     * Threads walk from seeds $seed(0), seed(1), \dots$ until they
+     * reach an element satisfying $distinguished$, and publish it
+     * with the start and length of their trail. When a point is
+     * already present from another trail, the two trails have
+     * merged, and the merge is located by re-walking them. Work is
+     * shared with no locks beyond slot claims, so the search scales
+     * nearly linearly with the number of threads.
+     * 
+     * Precondition: f and distinguished may be called concurrently,
+     * and distinguished points are spread through the orbits
+     * 
+     * @tparam F A type for transformation
+     * @tparam D A unary predicate type on the domain of f
+     * @tparam G A type for a function from walk indices to seeds
+     * @tparam H A hash function type for the domain of f
+     * @param f Some transformation
+     * @param distinguished The distinguishing predicate
+     * @param seed The seed generator
+     * @param pool The pool to run on
+     * @param options Tuning for the search
+     * @param hash The hash function
+     * @return The colliding pair and their common image, if found
+     * within the walk budget
+     */
+    template< transformation F, unary_predicate<eop::domain<F>> D, class G,
+              class H = std::hash<eop::domain<F>> >
+    std::optional<eop::triple<eop::domain<F>, eop::domain<F>, eop::domain<F>>>
+    distinguished_point_collision(F f, D distinguished, G seed,
+        eop::work_stealing_pool& pool,
+        const eop::distinguished_point_options& options = {}, H hash = H())
+    {
+        using T = eop::domain<F>;
+        using R = eop::triple<T, T, T>;
+        // A trail may run to max_trail steps, so it checks for a
+        // result once every poll + 1 of them
+        constexpr std::uint64_t poll = (std::uint64_t(1) << 16) - 1;
+        eop::distinguished_point_table<T, H> table(options.capacity, hash);
+        std::atomic<bool> done{false};
+        std::mutex mutex;
+        std::optional<R> result;
+        pool.parallel_for(options.max_walks, options.chunk,
+            [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+            {
+                if (done.load(std::memory_order_relaxed)) return;
+                T x0 = seed(i);
+                T x = x0;
+                std::uint64_t n = 0;
+                while (!distinguished(x))
+                {
+                    if (n == options.max_trail
+                        || ((n & poll) == poll && done.load(std::memory_order_relaxed)))
+                        break;
+                    x = f(x);
+                    n = n + 1;
+                }
+                // Abandoned, or stopped by a result
+                if (!distinguished(x)) continue;
+                auto e0 = table.insert(x, x0, n);
+                if (!e0.found) continue;
+                std::optional<R> r = eop::merge_trails(x0, n, e0.start, e0.length, f);
+                if (!r) continue;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!result) result = r;
+                done.store(true, std::memory_order_relaxed);
+                return;
+            }
+        });
+        return result;
+    }
+} // namespace eop
+
+#endif // !EOP_DISTINGUISHED_POINTS_HPP
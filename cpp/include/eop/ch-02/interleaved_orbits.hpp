@@ -0,0 +1,180 @@
+#ifndef EOP_INTERLEAVED_ORBITS_HPP
+#define EOP_INTERLEAVED_ORBITS_HPP
+
+#include "transorbs.hpp"
+#include "../simd.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Starts loading what $f(x)$ will read, when F
+     * specializes eop::prefetch_hint
+     *
+     * @tparam F A type for transformation
+     * @param f Some transformation
+     * @param x An element of the domain of f
+     */
+    template< transformation F >
+    inline
+    void prefetch_step(const F& f, const eop::domain<F>& x) noexcept
+    {
+        if constexpr (eop::is_prefetchable_transformation_v<F>)
+            eop::prefetch_hint<F>::prefetch(f, x);
+    }
+
+    /**
+     * @brief Computes $f^n$ of every seed in $[first, last)$,
+     * advancing K orbits in lockstep
+     *
+     * Each step applies f once to each of K independent orbits
+     * and hints the element it will read next, so that when f is
+     * a lookup in a table larger than the cache, up to K misses
+     * are in flight instead of one. Without eop::prefetch_hint
+     * the independent chains still let out-of-order execution
+     * overlap some misses. K is bounded in practice by the line
+     * fill buffers, 10 to 16 per core. Composable
+     * transformations are not memory bound, and are raised to
+     * the n-th power by eop::power_unary one seed at a time.
+     *
+     * @tparam K The number of orbits walked together
+     * @tparam I A random access iterator over the domain of f
+     * @tparam N An arithmetic type
+     * @tparam F A type for transformation
+     * @tparam O A random access iterator over the domain of f
+     * @param first The first seed
+     * @param last Past the last seed
+     * @param n The iterate number
+     * @param f Some transformation
+     * @param out The first output position
+     * @return O Past the last output position
+     */
+    template< std::size_t K = 16, random_access_iterator I, arithmetic N,
+              transformation F, random_access_iterator O >
+    O power_unary_interleaved(I first, I last, N n, F f, O out)
+    {
+        static_assert(K > 0);
+        using D = eop::domain<F>;
+        std::size_t m = std::size_t(last - first);
+        if constexpr (eop::is_composable_transformation_v<F> && std::is_integral_v<N>)
+        {
+            for (std::size_t i = 0; i < m; ++i)
+                out[i] = eop::power_unary(D(first[i]), n, f);
+        }
+        else
+        {
+            std::array<D, K> x;
+            for (std::size_t b = 0; b < m; b += K)
+            {
+                std::size_t k = m - b < K ? m - b : K;
+                for (std::size_t j = 0; j < k; ++j)
+                {
+                    x[j] = D(first[b + j]);
+                    eop::prefetch_step(f, x[j]);
+                }
+                if (k == K)
+                {
+                    for (N i = n; i != N(0); i = i - N(1))
+                        for (std::size_t j = 0; j < K; ++j)
+                        {
+                            x[j] = f(x[j]);
+                            eop::prefetch_step(f, x[j]);
+                        }
+                }
+                else
+                {
+                    for (N i = n; i != N(0); i = i - N(1))
+                        for (std::size_t j = 0; j < k; ++j)
+                        {
+                            x[j] = f(x[j]);
+                            eop::prefetch_step(f, x[j]);
+                        }
+                }
+                for (std::size_t j = 0; j < k; ++j) out[b + j] = x[j];
+            }
+        }
+        return out + m;
+    }
+
+    /**
+     * @brief Computes the minimal number of steps from every
+     * seed in $[first, last)$ to $y$ under $f$, walking K orbits
+     * at a time
+     *
+     * Orbits are interleaved as in eop::power_unary_interleaved.
+     * Since they reach y after different numbers of steps, a lane
+     * whose orbit has reached y takes the next seed at once, so
+     * that K misses stay in flight until fewer than K seeds
+     * remain. Distances are written to $out[i]$ for the i-th
+     * seed, whatever the order in which orbits finish.
+     *
+     * Precondition: $y$ is reachable from every seed
+     *
+     * @tparam K The number of orbits walked together
+     * @tparam I A random access iterator over the domain of f
+     * @tparam F A type for transformation
+     * @tparam O A random access iterator over distances
+     * @param first The first seed
+     * @param last Past the last seed
+     * @param y The target element
+     * @param f Some transformation
+     * @param out The first output position
+     * @return O Past the last output position
+     */
+    template< std::size_t K = 16, random_access_iterator I, transformation F,
+              random_access_iterator O >
+    O orbit_distances_interleaved(I first, I last, const eop::domain<F>& y, F f, O out)
+    {
+        static_assert(K > 0);
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+        std::size_t m = std::size_t(last - first);
+        std::array<D, K> x;
+        std::array<N, K> c;
+        std::array<std::size_t, K> seed;
+        std::size_t next = 0;
+        std::size_t active = 0;
+        for (; active < K && next < m; ++active, ++next)
+        {
+            x[active] = D(first[next]);
+            c[active] = N(0);
+            seed[active] = next;
+            eop::prefetch_step(f, x[active]);
+        }
+        while (active != 0)
+        {
+            std::size_t j = 0;
+            while (j < active)
+            {
+                if (x[j] != y)
+                {
+                    x[j] = f(x[j]);
+                    c[j] = c[j] + N(1);
+                    eop::prefetch_step(f, x[j]);
+                    ++j;
+                    continue;
+                }
+                out[seed[j]] = c[j];
+                if (next < m)
+                {
+                    x[j] = D(first[next]);
+                    c[j] = N(0);
+                    seed[j] = next++;
+                    eop::prefetch_step(f, x[j]);
+                    ++j;
+                }
+                else
+                {
+                    // Retire the lane, moving the last active one
+                    // into its place to be examined next
+                    --active;
+                    x[j] = x[active];
+                    c[j] = c[active];
+                    seed[j] = seed[active];
+                }
+            }
+        }
+        return out + m;
+    }
+} // namespace eop
+
+#endif // !EOP_INTERLEAVED_ORBITS_HPP
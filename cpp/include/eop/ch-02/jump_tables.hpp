@@ -0,0 +1,293 @@
+#ifndef EOP_JUMP_TABLES_HPP
+#define EOP_JUMP_TABLES_HPP
+
+#include "tabulated.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Binary-lifting table of $f^{2^k}$ over a finite
+     * domain, answering repeated power and distance queries
+     *
+     * Level k holds $f^{2^k}(i)$ for every i of the domain. Since
+     * every orbit has at most $size$ distinct elements, an
+     * exponent $n \geq size$ is first reduced to
+     * $h + (n - h) \bmod c$ using the functional graph, so no more
+     * than $\lceil \log_2 size \rceil$ levels are ever needed and
+     * the table takes at most $size \lceil \log_2 size \rceil$
+     * entries. Levels are built incrementally, when an exponent
+     * first needs them.
+     *
+     * $\func{power}$ applies one level per set bit of the reduced
+     * exponent, in $O(\log n)$; $\func{distance}$ is $O(1)$ from
+     * the handle lengths and cycle positions.
+     *
+     * @tparam F A type for transformation
+     */
+    template< transformation F >
+    class jump_table
+    {
+    public:
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+
+    private:
+        std::size_t _size;
+        std::vector<D> _levels;
+        std::size_t _level_count = 0;
+        eop::functional_graph<F> _graph;
+        /** Position of each cycle element from its cycle point */
+        std::vector<std::size_t> _position;
+
+        void locate_cycles()
+        {
+            _position.assign(_size, 0);
+            for (std::size_t c = 0; c < _graph.components(); ++c)
+            {
+                std::size_t i = eop::tabulation_index(_graph.cycle_point[c]);
+                for (std::size_t k = 0; k < _graph.cycle_size[c]; ++k)
+                {
+                    _position[i] = k;
+                    i = eop::tabulation_index(_levels[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Reduces n to an equivalent exponent below the
+         * domain size
+         *
+         */
+        std::size_t reduce(std::size_t i, std::uintmax_t n) const noexcept
+        {
+            if (n < _size) return std::size_t(n);
+            std::size_t h = std::size_t(_graph.handle[i]);
+            std::size_t c = _graph.cycle_size[_graph.component[i]];
+            return h + std::size_t((n - h) % c);
+        }
+
+    public:
+        /**
+         * @brief Builds the first level, and the functional graph,
+         * from an eagerly or lazily tabulated transformation
+         *
+         * @param f A tabulated transformation
+         */
+        explicit jump_table(const eop::tabulated<F>& f)
+            : _size(f.size()), _graph(f.analyze())
+        {
+            _levels.assign(f.data(), f.data() + _size);
+            _level_count = 1;
+            locate_cycles();
+        }
+
+        /**
+         * @brief Tabulates f over $[0, size)$, then builds as above
+         *
+         * @param f Some transformation
+         * @param size The size of the domain
+         */
+        jump_table(F f, std::size_t size)
+            : jump_table(eop::tabulated<F>(std::move(f), size, eop::tabulation::eager)) {}
+
+        std::size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        std::size_t levels() const noexcept
+        {
+            return _level_count;
+        }
+
+        const eop::functional_graph<F>& graph() const noexcept
+        {
+            return _graph;
+        }
+
+        /**
+         * @brief Builds levels until every exponent below
+         * $\min(n, size)$ can be answered
+         *
+         * @param n An exponent
+         */
+        void extend(std::size_t n)
+        {
+            if (n > _size) n = _size;
+            while ((std::size_t(1) << _level_count) < n)
+            {
+                std::size_t base = _levels.size() - _size;
+                _levels.resize(_levels.size() + _size);
+                const D* prev = _levels.data() + base;
+                D* next = _levels.data() + base + _size;
+                for (std::size_t i = 0; i < _size; ++i)
+                    next[i] = prev[eop::tabulation_index(prev[i])];
+                ++_level_count;
+            }
+        }
+
+        /**
+         * @brief Computes $f^n(x)$ in $O(\log n)$, extending the
+         * table when n needs more levels than it holds
+         *
+         * @tparam _N An integral type
+         * @param x An element of the domain
+         * @param n The iterate number
+         * @return D
+         */
+        template< class _N >
+        D power(D x, _N n)
+        {
+            static_assert(std::is_integral_v<_N>);
+            std::size_t m = reduce(eop::tabulation_index(x), std::uintmax_t(n));
+            if (m >= (std::size_t(1) << _level_count)) extend(m + 1);
+            return power_in_range(x, m);
+        }
+
+        /**
+         * @brief Computes $f^m(x)$ without extending the table
+         *
+         * Precondition: $m < 2^{levels()}$
+         *
+         * @param x An element of the domain
+         * @param m The iterate number
+         * @return D
+         */
+        D power_in_range(D x, std::size_t m) const noexcept
+        {
+            const D* level = _levels.data();
+            while (m != 0)
+            {
+                if (m & 1) x = level[eop::tabulation_index(x)];
+                m >>= 1;
+                level += _size;
+            }
+            return x;
+        }
+
+        /**
+         * @brief Computes the minimal number of steps from x to y
+         * in $O(1)$
+         *
+         * Precondition: y is reachable from x
+         *
+         * @param x An element of the domain
+         * @param y Another element of the domain
+         * @return N
+         */
+        N distance(D x, D y) const noexcept
+        {
+            std::size_t i = eop::tabulation_index(x);
+            std::size_t j = eop::tabulation_index(y);
+            if (_graph.handle[j] != N(0))
+                return N(_graph.handle[i] - _graph.handle[j]);
+            std::size_t k = eop::tabulation_index(_graph.connection[i]);
+            std::size_t c = _graph.cycle_size[_graph.component[i]];
+            std::size_t p = _position[k];
+            std::size_t q = _position[j];
+            return N(std::size_t(_graph.handle[i]) + (q >= p ? q - p : c - (p - q)));
+        }
+
+        /**
+         * @brief Whether y is reachable from x, in $O(\log n)$
+         *
+         * @param x An element of the domain
+         * @param y Another element of the domain
+         * @return bool
+         */
+        bool reachable(D x, D y)
+        {
+            std::size_t i = eop::tabulation_index(x);
+            std::size_t j = eop::tabulation_index(y);
+            if (_graph.component[i] != _graph.component[j]) return false;
+            if (_graph.handle[j] == N(0)) return true;
+            if (_graph.handle[j] > _graph.handle[i]) return false;
+            return power(x, std::size_t(_graph.handle[i] - _graph.handle[j])) == y;
+        }
+    };
+
+    /**
+     * @brief Cached doubling ladder $f, f^2, f^4, \ldots$ of a
+     * composable transformation, on any domain
+     *
+     * Each rung is composed once, when an exponent first needs
+     * it, so a sequence of $\func{power}$ queries costs
+     * $O(\log n)$ applications each, plus $O(\log n_{max})$
+     * compositions overall.
+     *
+     * @tparam F A type for composable transformation
+     */
+    template< composable_transformation F >
+    class jump_ladder
+    {
+    private:
+        static_assert(eop::is_composable_transformation_v<F>);
+        using C = eop::composition<F>;
+
+        std::vector<F> _rungs;
+
+    public:
+        explicit jump_ladder(F f)
+        {
+            _rungs.push_back(std::move(f));
+        }
+
+        std::size_t rungs() const noexcept
+        {
+            return _rungs.size();
+        }
+
+        /**
+         * @brief Composes rungs until every exponent below n can
+         * be answered
+         *
+         * @tparam _N An integral type
+         * @param n An exponent
+         */
+        template< class _N >
+        void extend(_N n)
+        {
+            static_assert(std::is_integral_v<_N>);
+            while (_rungs.size() < std::size_t(8 * sizeof(_N))
+                && (n >> (_rungs.size() - 1)) > _N(1))
+                _rungs.push_back(C::compose(_rungs.back(), _rungs.back()));
+        }
+
+        /**
+         * @brief The transformation $f^n$
+         *
+         * @tparam _N An integral type
+         * @param n The iterate number
+         * @return F
+         */
+        template< class _N >
+        F transformation_power(_N n)
+        {
+            extend(n);
+            F r = C::identity(_rungs.front());
+            for (std::size_t k = 0; n != _N(0); ++k, n = n / _N(2))
+                if (n % _N(2) != _N(0)) r = C::compose(r, _rungs[k]);
+            return r;
+        }
+
+        /**
+         * @brief Computes $f^n(x)$ by applying one rung per set
+         * bit of n
+         *
+         * @tparam _N An integral type
+         * @param x An element of the domain
+         * @param n The iterate number
+         * @return eop::domain<F>
+         */
+        template< class _N >
+        eop::domain<F> power(eop::domain<F> x, _N n)
+        {
+            extend(n);
+            for (std::size_t k = 0; n != _N(0); ++k, n = n / _N(2))
+                if (n % _N(2) != _N(0)) x = _rungs[k](x);
+            return x;
+        }
+    };
+} // namespace eop
+
+#endif // !EOP_JUMP_TABLES_HPP
@@ -0,0 +1,455 @@
+#ifndef EOP_NORMS_HPP
+#define EOP_NORMS_HPP
+
+#include "transorbs.hpp"
+#include "../simd.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Summation strategies for batch norms
+     * 
+     * naive accumulates in several independent registers;
+     * compensated carries a Kahan correction per lane and
+     * combines lanes with Neumaier's variant, bounding the
+     * relative error of the sum of squares by about $2u$ plus
+     * $O(n u^2)$ instead of $O(n u)$. Compensation relies on
+     * strict IEEE evaluation and is defeated by -ffast-math.
+     * 
+     */
+    enum class summation
+    {
+        naive,
+        compensated
+    };
+
+    /**
+     * @brief Scalar compensated (Neumaier) accumulator
+     * 
+     * @tparam _Tp A floating-point type
+     */
+    template< arithmetic _Tp >
+    struct compensated_sum
+    {
+        _Tp sum = _Tp(0);
+        _Tp correction = _Tp(0);
+
+        constexpr
+        void operator()(const _Tp& y) noexcept
+        {
+            _Tp t = sum + y;
+            if ((sum < _Tp(0) ? -sum : sum) >= (y < _Tp(0) ? -y : y))
+                correction = correction + ((sum - t) + y);
+            else
+                correction = correction + ((y - t) + sum);
+            sum = t;
+        }
+
+        constexpr
+        _Tp value() const noexcept
+        {
+            return sum + correction;
+        }
+    };
+
+    /**
+     * @brief Scalar kernel for the sum of squares of a
+     * counted range
+     * 
+     * @tparam _Tp An arithmetic type
+     * @tparam compensated Whether to use compensated summation
+     * @param x The first element
+     * @param n The element count
+     * @return _Tp 
+     */
+    template< arithmetic _Tp, bool compensated >
+    inline
+    _Tp sum_squares_scalar(const _Tp* x, std::size_t n) noexcept
+    {
+        if constexpr (compensated && std::is_floating_point_v<_Tp>)
+        {
+            eop::compensated_sum<_Tp> r;
+            for (std::size_t i = 0; i < n; ++i) r(x[i] * x[i]);
+            return r.value();
+        }
+        else
+        {
+            _Tp r0(0), r1(0), r2(0), r3(0);
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                r0 = r0 + x[i] * x[i];
+                r1 = r1 + x[i + 1] * x[i + 1];
+                r2 = r2 + x[i + 2] * x[i + 2];
+                r3 = r3 + x[i + 3] * x[i + 3];
+            }
+            for (; i < n; ++i) r0 = r0 + x[i] * x[i];
+            return (r0 + r1) + (r2 + r3);
+        }
+    }
+
+    /**
+     * @brief Scalar kernel for lane-wise sums of squares of
+     * points stored as structure-of-arrays, over the point
+     * indices $[i, n)$
+     * 
+     * @tparam _Tp An arithmetic type
+     * @tparam compensated Whether to use compensated summation
+     * @tparam root Whether to take the square root of each sum
+     * @param x Coordinate arrays, one per dimension
+     * @param y Coordinate arrays subtracted from x, or null
+     * @param dim The dimension
+     * @param i The first point index
+     * @param n The point count
+     * @param out One result per point
+     */
+    template< arithmetic _Tp, bool compensated, bool root >
+    inline
+    void soa_sum_squares_scalar(const _Tp* const* x, const _Tp* const* y,
+        std::size_t dim, std::size_t i, std::size_t n, _Tp* out) noexcept
+    {
+        for (; i < n; ++i)
+        {
+            eop::compensated_sum<_Tp> c;
+            _Tp s(0);
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                _Tp v = y ? _Tp(x[d][i] - y[d][i]) : x[d][i];
+                if constexpr (compensated && std::is_floating_point_v<_Tp>) c(v * v);
+                else s = s + v * v;
+            }
+            if constexpr (compensated && std::is_floating_point_v<_Tp>) s = c.value();
+            if constexpr (root) s = _Tp(std::sqrt(s));
+            out[i] = s;
+        }
+    }
+
+#if defined(EOP_SIMD_X86)
+    /**
+     * @brief Vector kernels for sums of squares, stamped out
+     * once per instruction set level
+     * 
+     * The bodies are shared; only the target attribute differs,
+     * since a kernel must be compiled for the instruction set
+     * of the lanes it uses. sum_squares_<level> reduces a counted
+     * range with four accumulators (naive) or one Kahan pair per
+     * lane (compensated); soa_sum_squares_<level> computes one
+     * sum per point, each lane holding a different point.
+     * 
+     */
+    #define EOP_NORM_KERNELS(level, target)                                              \
+    template< arithmetic _Tp, bool compensated >                                         \
+    target inline                                                                        \
+    _Tp sum_squares_##level(const _Tp* x, std::size_t n) noexcept                        \
+    {                                                                                    \
+        using S = eop::simd_lanes<eop::simd_level::level, _Tp>;                          \
+        using V = typename S::vector_type;                                               \
+        constexpr std::size_t W = S::width;                                              \
+        std::size_t i = 0;                                                               \
+        if constexpr (!compensated)                                                      \
+        {                                                                                \
+            V a0 = S::zero(), a1 = S::zero(), a2 = S::zero(), a3 = S::zero();            \
+            for (; i + 4 * W <= n; i += 4 * W)                                           \
+            {                                                                            \
+                V v0 = S::load(x + i), v1 = S::load(x + i + W);                          \
+                V v2 = S::load(x + i + 2 * W), v3 = S::load(x + i + 3 * W);              \
+                a0 = S::fmadd(v0, v0, a0);                                               \
+                a1 = S::fmadd(v1, v1, a1);                                               \
+                a2 = S::fmadd(v2, v2, a2);                                               \
+                a3 = S::fmadd(v3, v3, a3);                                               \
+            }                                                                            \
+            for (; i + W <= n; i += W)                                                   \
+            {                                                                            \
+                V v = S::load(x + i);                                                    \
+                a0 = S::fmadd(v, v, a0);                                                 \
+            }                                                                            \
+            _Tp r = S::hsum(S::add(S::add(a0, a1), S::add(a2, a3)));                     \
+            for (; i < n; ++i) r = r + x[i] * x[i];                                      \
+            return r;                                                                    \
+        }                                                                                \
+        else                                                                             \
+        {                                                                                \
+            V s = S::zero(), c = S::zero();                                              \
+            for (; i + W <= n; i += W)                                                   \
+            {                                                                            \
+                V v = S::load(x + i);                                                    \
+                V y = S::fmsub(v, v, c);                                                 \
+                V t = S::add(s, y);                                                      \
+                c = S::sub(S::sub(t, s), y);                                             \
+                s = t;                                                                   \
+            }                                                                            \
+            _Tp sl[W], cl[W];                                                            \
+            S::store(sl, s);                                                             \
+            S::store(cl, c);                                                             \
+            eop::compensated_sum<_Tp> r;                                                 \
+            for (std::size_t k = 0; k < W; ++k)                                          \
+            {                                                                            \
+                r(sl[k]);                                                                \
+                r(-cl[k]);                                                               \
+            }                                                                            \
+            for (; i < n; ++i) r(x[i] * x[i]);                                           \
+            return r.value();                                                            \
+        }                                                                                \
+    }                                                                                    \
+                                                                                         \
+    template< arithmetic _Tp, bool compensated, bool root >                              \
+    target inline                                                                        \
+    void soa_sum_squares_##level(const _Tp* const* x, const _Tp* const* y,               \
+        std::size_t dim, std::size_t n, _Tp* out) noexcept                               \
+    {                                                                                    \
+        using S = eop::simd_lanes<eop::simd_level::level, _Tp>;                          \
+        using V = typename S::vector_type;                                               \
+        constexpr std::size_t W = S::width;                                              \
+        std::size_t i = 0;                                                               \
+        for (; i + W <= n; i += W)                                                       \
+        {                                                                                \
+            V s = S::zero(), c = S::zero();                                              \
+            for (std::size_t d = 0; d < dim; ++d)                                        \
+            {                                                                            \
+                V v = S::load(x[d] + i);                                                 \
+                if (y) v = S::sub(v, S::load(y[d] + i));                                 \
+                if constexpr (!compensated)                                              \
+                {                                                                        \
+                    s = S::fmadd(v, v, s);                                               \
+                }                                                                        \
+                else                                                                     \
+                {                                                                        \
+                    V u = S::fmsub(v, v, c);                                             \
+                    V t = S::add(s, u);                                                  \
+                    c = S::sub(S::sub(t, s), u);                                         \
+                    s = t;                                                               \
+                }                                                                        \
+            }                                                                            \
+            if constexpr (compensated) s = S::sub(s, c);                                 \
+            if constexpr (root) s = S::sqrt(s);                                          \
+            S::store(out + i, s);                                                        \
+        }                                                                                \
+        eop::soa_sum_squares_scalar<_Tp, compensated, root>(x, y, dim, i, n, out);       \
+    }
+
+    EOP_NORM_KERNELS(sse2, )
+    EOP_NORM_KERNELS(avx2, EOP_TARGET_AVX2)
+    EOP_NORM_KERNELS(avx512, EOP_TARGET_AVX512)
+
+    #undef EOP_NORM_KERNELS
+#endif // EOP_SIMD_X86
+
+    /**
+     * @brief Dispatches the sum of squares of a counted range
+     * to the widest available kernel
+     * 
+     * @tparam _Tp An arithmetic type
+     * @tparam compensated Whether to use compensated summation
+     */
+    template< arithmetic _Tp, bool compensated >
+    inline
+    _Tp sum_squares_dispatch(const _Tp* x, std::size_t n,
+        eop::simd_level l) noexcept
+    {
+    #if defined(EOP_SIMD_X86)
+        if constexpr (std::is_same_v<_Tp, float> || std::is_same_v<_Tp, double>)
+        {
+            switch (eop::simd_clamp(l))
+            {
+            case eop::simd_level::avx512: return eop::sum_squares_avx512<_Tp, compensated>(x, n);
+            case eop::simd_level::avx2: return eop::sum_squares_avx2<_Tp, compensated>(x, n);
+            case eop::simd_level::sse2: return eop::sum_squares_sse2<_Tp, compensated>(x, n);
+            case eop::simd_level::scalar: break;
+            }
+        }
+    #endif
+        (void)l;
+        return eop::sum_squares_scalar<_Tp, compensated>(x, n);
+    }
+
+    /**
+     * @brief Dispatches lane-wise sums of squares over
+     * structure-of-arrays points to the widest available kernel
+     * 
+     * @tparam _Tp An arithmetic type
+     * @tparam compensated Whether to use compensated summation
+     * @tparam root Whether to take the square root of each sum
+     */
+    template< arithmetic _Tp, bool compensated, bool root >
+    inline
+    void soa_sum_squares_dispatch(const _Tp* const* x, const _Tp* const* y,
+        std::size_t dim, std::size_t n, _Tp* out, eop::simd_level l) noexcept
+    {
+    #if defined(EOP_SIMD_X86)
+        if constexpr (std::is_same_v<_Tp, float> || std::is_same_v<_Tp, double>)
+        {
+            switch (eop::simd_clamp(l))
+            {
+            case eop::simd_level::avx512:
+                return eop::soa_sum_squares_avx512<_Tp, compensated, root>(x, y, dim, n, out);
+            case eop::simd_level::avx2:
+                return eop::soa_sum_squares_avx2<_Tp, compensated, root>(x, y, dim, n, out);
+            case eop::simd_level::sse2:
+                return eop::soa_sum_squares_sse2<_Tp, compensated, root>(x, y, dim, n, out);
+            case eop::simd_level::scalar: break;
+            }
+        }
+    #endif
+        (void)l;
+        eop::soa_sum_squares_scalar<_Tp, compensated, root>(x, y, dim, 0, n, out);
+    }
+
+    /**
+     * @brief Computes the squared euclidean (L2) norm of a
+     * vector given as a counted range
+     * 
+     * @tparam _Tp An arithmetic type
+     * @param x The first element
+     * @param n The element count
+     * @param s The summation strategy
+     * @param l The widest instruction set level to use
+     * @return _Tp 
+     */
+    template< arithmetic _Tp >
+    inline
+    _Tp squared_norm_n(const _Tp* x, std::size_t n,
+        eop::summation s = eop::summation::naive,
+        eop::simd_level l = eop::simd_level::avx512) noexcept
+    {
+        static_assert(std::is_arithmetic_v<_Tp>);
+        if (s == eop::summation::compensated)
+            return eop::sum_squares_dispatch<_Tp, true>(x, n, l);
+        return eop::sum_squares_dispatch<_Tp, false>(x, n, l);
+    }
+
+    /**
+     * @brief Computes the euclidean (L2) norm of a vector
+     * given as a counted range
+     * 
+     * @tparam _Tp An arithmetic type
+     * @param x The first element
+     * @param n The element count
+     * @param s The summation strategy
+     * @param l The widest instruction set level to use
+     * @return _Tp 
+     */
+    template< arithmetic _Tp >
+    inline
+    _Tp euclidean_norm_n(const _Tp* x, std::size_t n,
+        eop::summation s = eop::summation::naive,
+        eop::simd_level l = eop::simd_level::avx512) noexcept
+    {
+        return _Tp(std::sqrt(eop::squared_norm_n(x, n, s, l)));
+    }
+
+    /**
+     * @brief Computes the squared euclidean (L2) norm of each
+     * of n points of dimension dim, stored as structure-of-arrays
+     * 
+     * Precondition: x[d] and out each hold n elements
+     * 
+     * @tparam _Tp An arithmetic type
+     * @param x Coordinate arrays, one per dimension
+     * @param dim The dimension
+     * @param n The point count
+     * @param out One squared norm per point
+     * @param s The summation strategy
+     * @param l The widest instruction set level to use
+     */
+    template< arithmetic _Tp >
+    inline
+    void squared_norms_soa(const _Tp* const* x, std::size_t dim, std::size_t n,
+        _Tp* out, eop::summation s = eop::summation::naive,
+        eop::simd_level l = eop::simd_level::avx512) noexcept
+    {
+        static_assert(std::is_arithmetic_v<_Tp>);
+        if (s == eop::summation::compensated)
+            eop::soa_sum_squares_dispatch<_Tp, true, false>(x, nullptr, dim, n, out, l);
+        else
+            eop::soa_sum_squares_dispatch<_Tp, false, false>(x, nullptr, dim, n, out, l);
+    }
+
+    /**
+     * @brief Computes the euclidean (L2) norm of each of n
+     * points of dimension dim, stored as structure-of-arrays
+     * 
+     * Precondition: x[d] and out each hold n elements
+     * 
+     * @tparam _Tp An arithmetic type
+     * @param x Coordinate arrays, one per dimension
+     * @param dim The dimension
+     * @param n The point count
+     * @param out One norm per point
+     * @param s The summation strategy
+     * @param l The widest instruction set level to use
+     */
+    template< arithmetic _Tp >
+    inline
+    void euclidean_norms_soa(const _Tp* const* x, std::size_t dim, std::size_t n,
+        _Tp* out, eop::summation s = eop::summation::naive,
+        eop::simd_level l = eop::simd_level::avx512) noexcept
+    {
+        static_assert(std::is_arithmetic_v<_Tp>);
+        if (s == eop::summation::compensated)
+            eop::soa_sum_squares_dispatch<_Tp, true, true>(x, nullptr, dim, n, out, l);
+        else
+            eop::soa_sum_squares_dispatch<_Tp, false, true>(x, nullptr, dim, n, out, l);
+    }
+
+    /**
+     * @brief Computes the squared euclidean distance between
+     * corresponding points of two arrays of n points of dimension
+     * dim, both stored as structure-of-arrays
+     * 
+     * Precondition: x[d], y[d] and out each hold n elements
+     * 
+     * @tparam _Tp An arithmetic type
+     * @param x Coordinate arrays of the first points
+     * @param y Coordinate arrays of the second points
+     * @param dim The dimension
+     * @param n The point count
+     * @param out One squared distance per pair of points
+     * @param s The summation strategy
+     * @param l The widest instruction set level to use
+     */
+    template< arithmetic _Tp >
+    inline
+    void squared_distances_soa(const _Tp* const* x, const _Tp* const* y,
+        std::size_t dim, std::size_t n, _Tp* out,
+        eop::summation s = eop::summation::naive,
+        eop::simd_level l = eop::simd_level::avx512) noexcept
+    {
+        static_assert(std::is_arithmetic_v<_Tp>);
+        if (s == eop::summation::compensated)
+            eop::soa_sum_squares_dispatch<_Tp, true, false>(x, y, dim, n, out, l);
+        else
+            eop::soa_sum_squares_dispatch<_Tp, false, false>(x, y, dim, n, out, l);
+    }
+
+    /**
+     * @brief Computes the euclidean distance between
+     * corresponding points of two arrays of n points of dimension
+     * dim, both stored as structure-of-arrays
+     * 
+     * Precondition: x[d], y[d] and out each hold n elements
+     * 
+     * @tparam _Tp An arithmetic type
+     * @param x Coordinate arrays of the first points
+     * @param y Coordinate arrays of the second points
+     * @param dim The dimension
+     * @param n The point count
+     * @param out One distance per pair of points
+     * @param s The summation strategy
+     * @param l The widest instruction set level to use
+     */
+    template< arithmetic _Tp >
+    inline
+    void euclidean_distances_soa(const _Tp* const* x, const _Tp* const* y,
+        std::size_t dim, std::size_t n, _Tp* out,
+        eop::summation s = eop::summation::naive,
+        eop::simd_level l = eop::simd_level::avx512) noexcept
+    {
+        static_assert(std::is_arithmetic_v<_Tp>);
+        if (s == eop::summation::compensated)
+            eop::soa_sum_squares_dispatch<_Tp, true, true>(x, y, dim, n, out, l);
+        else
+            eop::soa_sum_squares_dispatch<_Tp, false, true>(x, y, dim, n, out, l);
+    }
+} // namespace eop
+
+#endif // !EOP_NORMS_HPP
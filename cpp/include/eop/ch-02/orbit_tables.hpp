@@ -0,0 +1,183 @@
+#ifndef EOP_ORBIT_TABLES_HPP
+#define EOP_ORBIT_TABLES_HPP
+
+#include "tabulated.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Computes the size of the cycle reached by the orbit
+     * of $x$ under $f$, by the first phase of Brent's algorithm
+     *
+     * Usable in constant expressions, e.g. to fix the period of a
+     * generator at compile time; periods beyond the compiler's
+     * constant-evaluation loop limit (262144 iterations by default
+     * with GCC) need a higher -fconstexpr-loop-limit.
+     *
+     * Precondition: the orbit of $x$ under $f$ is nonterminating
+     *
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @return eop::distance_type<F>
+     */
+    template< transformation F >
+    constexpr
+    eop::distance_type<F> orbit_period(const eop::domain<F>& x, F f) noexcept
+    {
+        using N = eop::distance_type<F>;
+        N power(1);
+        N c(1);
+        eop::domain<F> slow = x;
+        eop::domain<F> fast = f(x);
+        while (fast != slow)
+        {
+            if (power == c)
+            {
+                slow = fast;
+                power = power + power;
+                c = N(0);
+            }
+            fast = f(fast);
+            c = c + N(1);
+        }
+        return c;
+    }
+
+    /**
+     * @brief One step of a Galois linear feedback shift register,
+     * shifting right and folding the output bit into the taps
+     *
+     * A maximal-length register of w bits has period $2^w - 1$ on
+     * every nonzero state, e.g. $taps = \mathtt{0xB400}$ for 16 bits.
+     *
+     * @tparam _Tp An unsigned integral type
+     */
+    template< arithmetic _Tp >
+    struct galois_lfsr
+    {
+        _Tp taps;
+
+        constexpr _Tp operator()(_Tp x) const noexcept
+        {
+            return _Tp((x >> 1) ^ ((_Tp(0) - _Tp(x & _Tp(1))) & taps));
+        }
+    };
+
+    template< arithmetic _Tp >
+    struct input<eop::galois_lfsr<_Tp>, 0>
+    {
+        using type = _Tp;
+    };
+
+    /**
+     * @brief Tabulates f over $[0, Size)$ into an array
+     *
+     * @tparam Size The size of the domain
+     * @tparam F A type for transformation
+     * @param f Some transformation
+     * @return std::array<eop::domain<F>, Size>
+     */
+    template< std::size_t Size, transformation F >
+    constexpr
+    std::array<eop::domain<F>, Size> tabulate_array(F f) noexcept
+    {
+        using D = eop::domain<F>;
+        std::array<D, Size> table{};
+        for (std::size_t i = 0; i < Size; ++i)
+            table[i] = f(eop::tabulation_value<D>(i));
+        return table;
+    }
+
+    /**
+     * @brief Functional graph of a transformation on a domain of
+     * Size elements, in fixed arrays so that it can be a constant
+     *
+     * Only the first $\func{cycles}$ entries of $\func{cycle_size}$
+     * and $\func{cycle_point}$ are meaningful.
+     *
+     * @tparam F A type for transformation
+     * @tparam Size The size of the domain
+     */
+    template< transformation F, std::size_t Size >
+    struct static_functional_graph
+    {
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+
+        std::array<N, Size> handle{};
+        std::array<D, Size> connection{};
+        std::array<std::size_t, Size> component{};
+        /**
+         * Size of each cycle, which for a cycle through the whole
+         * domain is one more than N can hold
+         */
+        std::array<std::size_t, Size> cycle_size{};
+        std::array<D, Size> cycle_point{};
+        std::size_t cycles = 0;
+
+        constexpr std::size_t components() const noexcept
+        {
+            return cycles;
+        }
+
+        /**
+         * @brief The shape of the orbit of x, with the
+         * conventions of eop::orbit_structure
+         *
+         * @param x An element of the domain
+         * @return eop::orbit_shape<F>
+         */
+        constexpr eop::orbit_shape<F> shape(const D& x) const noexcept
+        {
+            std::size_t i = eop::tabulation_index(x);
+            return { handle[i], N(cycle_size[component[i]] - 1), connection[i] };
+        }
+    };
+
+    /**
+     * @brief Computes the functional graph of a tabulated
+     * transformation in $O(Size)$, in a constant expression if
+     * need be
+     *
+     * For a permutation every handle is zero and the components
+     * are its cycles, so e.g.
+     * $static\_functional\_graph::cycle\_size$ lists the cycle
+     * lengths of a permutation table generated at compile time.
+     *
+     * Precondition: every entry of table is in $[0, Size)$
+     *
+     * @tparam F A type for transformation
+     * @tparam Size The size of the domain
+     * @param table $f(i)$ at position i
+     * @return eop::static_functional_graph<F, Size>
+     */
+    template< transformation F, std::size_t Size >
+    constexpr
+    eop::static_functional_graph<F, Size> analyze_array(
+        const std::array<eop::domain<F>, Size>& table) noexcept
+    {
+        eop::static_functional_graph<F, Size> g;
+        std::array<std::size_t, Size> path{};
+        g.cycles = eop::analyze_table_into<F>(table.data(), Size, g, path);
+        return g;
+    }
+
+    /**
+     * @brief Tabulates f over $[0, Size)$ and computes its
+     * functional graph, in a constant expression if need be
+     *
+     * @tparam Size The size of the domain
+     * @tparam F A type for transformation
+     * @param f Some transformation
+     * @return eop::static_functional_graph<F, Size>
+     */
+    template< std::size_t Size, transformation F >
+    constexpr
+    eop::static_functional_graph<F, Size> analyze_domain(F f) noexcept
+    {
+        return eop::analyze_array<F, Size>(eop::tabulate_array<Size>(f));
+    }
+} // namespace eop
+
+#endif // !EOP_ORBIT_TABLES_HPP
@@ -0,0 +1,232 @@
+#ifndef EOP_ORBIT_VIEW_HPP
+#define EOP_ORBIT_VIEW_HPP
+
+#include "transorbs.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Lazy view of the orbit $x, f(x), f^2(x), \ldots$
+     *
+     * The iterator holds the current element and its distance
+     * from $x$, and applies f only when incremented, so an orbit
+     * is streamed in constant memory and without allocation.
+     * Distances are counted in std::uint64_t rather than N, which
+     * cannot count the elements of a cycle through the whole
+     * domain. The view is unbounded unless restricted by
+     * - $\func{take}(n)$, to the first n elements;
+     * - $\func{until}(y)$, to the elements before y, i.e.
+     *   $\func{orbit_distance}(x, y, f)$ of them;
+     * - $\func{until_cycle}()$, to the distinct elements of the
+     *   orbit, ending just before the first repetition (or with the
+     *   terminal element of a terminating orbit). The number of
+     *   distinct elements is computed once, by Brent's algorithm in
+     *   constant memory, when $\func{until_cycle}$ is called.
+     *
+     * f is never applied past the last element of a bounded view.
+     * Iterators are forward iterators and refer to the view's
+     * transformation, as those of the standard views do.
+     *
+     * @tparam F A type for transformation
+     */
+    template< transformation F >
+    class orbit_view : public std::ranges::view_interface<eop::orbit_view<F>>
+    {
+    public:
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+
+    private:
+        D _x;
+        F _f;
+        bool _bounded = false;
+        std::uint64_t _limit = 0;
+        std::optional<D> _y;
+
+        class sentinel
+        {
+        private:
+            std::optional<D> _y;
+
+            friend class orbit_view;
+
+            explicit sentinel(const std::optional<D>& y) : _y(y) {}
+
+        public:
+            sentinel() = default;
+
+            bool matches(const D& x) const noexcept
+            {
+                return _y && x == *_y;
+            }
+        };
+
+        template< bool Const >
+        class iterator_type
+        {
+        private:
+            using G = std::conditional_t<Const, const F, F>;
+
+            D _x;
+            G* _f = nullptr;
+            std::uint64_t _n = 0;
+            bool _bounded = false;
+            std::uint64_t _limit = 0;
+
+            friend class orbit_view;
+
+            iterator_type(const D& x, G* f, bool bounded, std::uint64_t limit) noexcept
+                : _x(x), _f(f), _bounded(bounded), _limit(limit) {}
+
+            bool exhausted() const noexcept
+            {
+                return _bounded && _n == _limit;
+            }
+
+        public:
+            using value_type = D;
+            using difference_type = std::ptrdiff_t;
+            using reference = D;
+            using pointer = void;
+            using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::forward_iterator_tag;
+
+            iterator_type() = default;
+
+            D operator*() const noexcept
+            {
+                return _x;
+            }
+
+            /**
+             * @brief The number of increments from the start of
+             * the orbit
+             *
+             * @return std::uint64_t
+             */
+            std::uint64_t count() const noexcept
+            {
+                return _n;
+            }
+
+            iterator_type& operator++()
+            {
+                ++_n;
+                if (!exhausted()) _x = (*_f)(_x);
+                return *this;
+            }
+
+            iterator_type operator++(int)
+            {
+                iterator_type i = *this;
+                ++*this;
+                return i;
+            }
+
+            friend bool operator==(const iterator_type& i, const iterator_type& j) noexcept
+            {
+                return i._n == j._n;
+            }
+
+            friend bool operator==(const iterator_type& i, const sentinel& s) noexcept
+            {
+                return i.exhausted() || s.matches(i._x);
+            }
+        };
+
+    public:
+        using iterator = iterator_type<false>;
+        using const_iterator = iterator_type<true>;
+
+        orbit_view() requires std::default_initializable<D>
+            && std::default_initializable<F> = default;
+
+        orbit_view(D x, F f) : _x(std::move(x)), _f(std::move(f)) {}
+
+        iterator begin()
+        {
+            return iterator(_x, &_f, _bounded, _limit);
+        }
+
+        const_iterator begin() const
+            requires std::regular_invocable<const F&, D>
+        {
+            return const_iterator(_x, &_f, _bounded, _limit);
+        }
+
+        sentinel end() const
+        {
+            return sentinel(_y);
+        }
+
+        const D& start() const noexcept
+        {
+            return _x;
+        }
+
+        /**
+         * @brief The view of at most the first n elements
+         *
+         * @param n The number of elements
+         * @return orbit_view
+         */
+        orbit_view take(std::uint64_t n) const
+        {
+            orbit_view v = *this;
+            if (!v._bounded || n < v._limit) v._limit = n;
+            v._bounded = true;
+            return v;
+        }
+
+        /**
+         * @brief The view ending just before y
+         *
+         * Precondition: y is reachable from the start, or the view
+         * is otherwise bounded
+         *
+         * @param y An element of the domain of f
+         * @return orbit_view
+         */
+        orbit_view until(D y) const
+        {
+            orbit_view v = *this;
+            v._y = std::move(y);
+            return v;
+        }
+
+        /**
+         * @brief The view of the distinct elements of a
+         * nonterminating orbit
+         *
+         * @return orbit_view
+         */
+        orbit_view until_cycle() const
+        {
+            eop::orbit_shape<F> s = eop::orbit_structure_brent_nonterminating_orbit(_x, _f);
+            return take(std::uint64_t(s.m0) + std::uint64_t(s.m1) + 1);
+        }
+
+        /**
+         * @brief The view of the distinct elements of an orbit,
+         * ending with the terminal element if it terminates
+         *
+         * Precondition: $p(x) \Leftrightarrow f(x)$ is defined
+         *
+         * @tparam P A unary predicate type for the definition space
+         * of f
+         * @param p The definition-space predicate of f
+         * @return orbit_view
+         */
+        template< unary_predicate<D> P >
+        orbit_view until_cycle(P p) const
+        {
+            eop::orbit_shape<F> s = eop::orbit_structure_brent(_x, _f, p);
+            return take(std::uint64_t(s.m0) + std::uint64_t(s.m1) + 1);
+        }
+    };
+
+    template< transformation F >
+    orbit_view(eop::domain<F>, F) -> orbit_view<F>;
+} // namespace eop
+
+#endif // !EOP_ORBIT_VIEW_HPP
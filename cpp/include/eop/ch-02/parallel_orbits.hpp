@@ -0,0 +1,136 @@
+#ifndef EOP_PARALLEL_ORBITS_HPP
+#define EOP_PARALLEL_ORBITS_HPP
+
+#include "transorbs.hpp"
+#include "../executor.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Computes the shape of the orbit of every seed in
+     * $[first, last)$ under $f$, spreading seeds over a pool
+     * 
+     * The shape of the i-th seed is written to $out[i]$, so
+     * results do not depend on the number of threads or on the
+     * order in which chunks run.
+     * 
+     * Precondition: every orbit is nonterminating, and f may be
+     * called concurrently from several threads
+     * 
+     * @tparam I A random access iterator over the domain of f
+     * @tparam F A type for transformation
+     * @tparam O A random access iterator over orbit shapes
+     * @param first The first seed
+     * @param last Past the last seed
+     * @param f Some transformation
+     * @param out The first output position
+     * @param pool The pool to run on
+     * @param chunk The number of seeds per work item, or zero
+     * to let the pool choose
+     * @return O Past the last output position
+     */
+    template< random_access_iterator I, transformation F, random_access_iterator O >
+    O parallel_orbits(I first, I last, F f, O out, eop::work_stealing_pool& pool,
+        std::size_t chunk = 0)
+    {
+        std::size_t n = std::size_t(last - first);
+        pool.parallel_for(n, chunk, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+                out[i] = eop::orbit_structure_brent_nonterminating_orbit(
+                    eop::domain<F>(first[i]), f);
+        });
+        return out + n;
+    }
+
+    /**
+     * @brief Computes the shape of the orbit of every seed in
+     * $[first, last)$ under $f$, on the default pool
+     * 
+     * @tparam I A random access iterator over the domain of f
+     * @tparam F A type for transformation
+     * @tparam O A random access iterator over orbit shapes
+     * @param first The first seed
+     * @param last Past the last seed
+     * @param f Some transformation
+     * @param out The first output position
+     * @return O Past the last output position
+     */
+    template< random_access_iterator I, transformation F, random_access_iterator O >
+    O parallel_orbits(I first, I last, F f, O out)
+    {
+        return eop::parallel_orbits(first, last, f, out, eop::default_pool());
+    }
+
+    /**
+     * @brief Computes the shape of the orbit of every seed in
+     * $[first, last)$ under a partial transformation $f$,
+     * spreading seeds over a pool
+     * 
+     * Precondition: $p(x) \Leftrightarrow f(x)$ is defined, and
+     * f and p may be called concurrently from several threads
+     * 
+     * @tparam I A random access iterator over the domain of f
+     * @tparam F A type for transformation
+     * @tparam P A unary predicate type for the definition space
+     * of f
+     * @tparam O A random access iterator over orbit shapes
+     * @param first The first seed
+     * @param last Past the last seed
+     * @param f Some transformation
+     * @param p The definition-space predicate of f
+     * @param out The first output position
+     * @param pool The pool to run on
+     * @param chunk The number of seeds per work item, or zero
+     * to let the pool choose
+     * @return O Past the last output position
+     */
+    template< random_access_iterator I, transformation F, unary_predicate<eop::domain<F>> P,
+              random_access_iterator O >
+    O parallel_orbits(I first, I last, F f, P p, O out,
+        eop::work_stealing_pool& pool, std::size_t chunk = 0)
+    {
+        std::size_t n = std::size_t(last - first);
+        pool.parallel_for(n, chunk, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+                out[i] = eop::orbit_structure_brent(eop::domain<F>(first[i]), f, p);
+        });
+        return out + n;
+    }
+
+    /**
+     * @brief Computes the minimal number of steps from every
+     * seed in $[first, last)$ to $y$ under $f$, spreading seeds
+     * over a pool
+     * 
+     * Precondition: $y$ is reachable from every seed
+     * 
+     * @tparam I A random access iterator over the domain of f
+     * @tparam F A type for transformation
+     * @tparam O A random access iterator over distances
+     * @param first The first seed
+     * @param last Past the last seed
+     * @param y The target element
+     * @param f Some transformation
+     * @param out The first output position
+     * @param pool The pool to run on
+     * @param chunk The number of seeds per work item, or zero
+     * to let the pool choose
+     * @return O Past the last output position
+     */
+    template< random_access_iterator I, transformation F, random_access_iterator O >
+    O parallel_orbit_distances(I first, I last, const eop::domain<F>& y, F f, O out,
+        eop::work_stealing_pool& pool, std::size_t chunk = 0)
+    {
+        std::size_t n = std::size_t(last - first);
+        pool.parallel_for(n, chunk, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+                out[i] = eop::orbit_distance(eop::domain<F>(first[i]), y, f);
+        });
+        return out + n;
+    }
+} // namespace eop
+
+#endif // !EOP_PARALLEL_ORBITS_HPP
@@ -0,0 +1,385 @@
+#ifndef EOP_TABULATED_HPP
+#define EOP_TABULATED_HPP
+
+#include "transorbs.hpp"
+#include "../executor.hpp"
+#include "../simd.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Maps an element of a finite domain to its
+     * position in a table, through the unsigned representation
+     * of its (underlying) integral type
+     *
+     * @tparam _Tp An integral or enumeration type
+     * @param x An element
+     * @return std::size_t
+     */
+    template< class _Tp >
+    inline
+    constexpr
+    std::size_t tabulation_index(_Tp x) noexcept
+    {
+        if constexpr (std::is_enum_v<_Tp>)
+            return eop::tabulation_index(static_cast<std::underlying_type_t<_Tp>>(x));
+        else
+            return std::size_t(static_cast<std::make_unsigned_t<_Tp>>(x));
+    }
+
+    /**
+     * @brief Inverse of eop::tabulation_index
+     *
+     * @tparam _Tp An integral or enumeration type
+     * @param i A table position
+     * @return _Tp
+     */
+    template< class _Tp >
+    inline
+    constexpr
+    _Tp tabulation_value(std::size_t i) noexcept
+    {
+        if constexpr (std::is_enum_v<_Tp>)
+            return static_cast<_Tp>(eop::tabulation_value<std::underlying_type_t<_Tp>>(i));
+        else
+            return _Tp(static_cast<std::make_unsigned_t<_Tp>>(i));
+    }
+
+    /**
+     * @brief Whether a table entry is computed when the
+     * transformation is built, or on first use
+     *
+     */
+    enum class tabulation
+    {
+        lazy,
+        eager
+    };
+
+    /**
+     * @brief Shapes of every orbit of a transformation on a
+     * finite domain, i.e. the structure of its functional graph
+     *
+     * Every orbit in a finite domain closed under f is
+     * nonterminating, and every weakly connected component of the
+     * functional graph contains exactly one cycle, so components
+     * are identified with their cycles.
+     *
+     * @tparam F A type for transformation
+     */
+    template< transformation F >
+    struct functional_graph
+    {
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+
+        /** Distance from each element to its cycle */
+        std::vector<N> handle;
+        /** Point where the orbit of each element enters its cycle */
+        std::vector<D> connection;
+        /** Cycle, and component, of each element */
+        std::vector<std::size_t> component;
+        /**
+         * Size of each cycle, which for a cycle through the whole
+         * domain is one more than N can hold
+         */
+        std::vector<std::size_t> cycle_size;
+        /** One point of each cycle */
+        std::vector<D> cycle_point;
+
+        std::size_t components() const noexcept
+        {
+            return cycle_size.size();
+        }
+
+        /**
+         * @brief The shape of the orbit of x, with the
+         * conventions of eop::orbit_structure
+         *
+         * @param x An element of the domain
+         * @return eop::orbit_shape<F>
+         */
+        eop::orbit_shape<F> shape(const D& x) const noexcept
+        {
+            std::size_t i = eop::tabulation_index(x);
+            return { handle[i], N(cycle_size[component[i]] - 1), connection[i] };
+        }
+    };
+
+    /**
+     * @brief Computes the functional graph of the transformation
+     * given by a table over $[0, n)$ into preallocated storage, in
+     * $O(n)$ time and at compile time if need be
+     *
+     * Each unvisited element starts a walk that stops at the
+     * first visited element; if that element is on the walk
+     * itself, a new cycle has been found. The walk is then
+     * unwound, each element taking its successor's cycle and
+     * connection point and one more than its handle.
+     *
+     * Precondition: $table[i]$ is in $[0, n)$ for all i; the
+     * members of g and path hold n elements each
+     *
+     * @tparam F A type for transformation
+     * @tparam G A type with indexable members handle, connection,
+     * component, cycle_size and cycle_point
+     * @tparam Path An indexable type of std::size_t
+     * @param table $f(i)$ at position i
+     * @param n The size of the domain
+     * @param g The output graph
+     * @param path Scratch storage
+     * @return std::size_t The number of cycles
+     */
+    template< transformation F, class G, class Path >
+    constexpr
+    std::size_t analyze_table_into(const eop::domain<F>* table, std::size_t n,
+        G& g, Path& path) noexcept
+    {
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+        constexpr std::size_t unvisited = ~std::size_t(0);
+        constexpr std::size_t on_path = unvisited - 1;
+
+        for (std::size_t i = 0; i < n; ++i) g.component[i] = unvisited;
+        std::size_t cycles = 0;
+        for (std::size_t s = 0; s < n; ++s)
+        {
+            if (g.component[s] != unvisited) continue;
+            std::size_t length = 0;
+            std::size_t i = s;
+            while (g.component[i] == unvisited)
+            {
+                g.component[i] = on_path;
+                g.handle[i] = N(length);
+                path[length++] = i;
+                i = eop::tabulation_index(table[i]);
+            }
+            std::size_t end = length;
+            if (g.component[i] == on_path)
+            {
+                // The walk closed a new cycle starting at position handle[i]
+                std::size_t first = std::size_t(g.handle[i]);
+                g.cycle_size[cycles] = end - first;
+                g.cycle_point[cycles] = eop::tabulation_value<D>(i);
+                for (std::size_t k = first; k < end; ++k)
+                {
+                    std::size_t j = path[k];
+                    g.component[j] = cycles;
+                    g.handle[j] = N(0);
+                    g.connection[j] = eop::tabulation_value<D>(j);
+                }
+                ++cycles;
+                end = first;
+            }
+            while (end > 0)
+            {
+                std::size_t j = path[--end];
+                std::size_t k = eop::tabulation_index(table[j]);
+                g.component[j] = g.component[k];
+                g.handle[j] = N(g.handle[k] + N(1));
+                g.connection[j] = g.connection[k];
+            }
+        }
+        return cycles;
+    }
+
+    /**
+     * @brief Computes the functional graph of the transformation
+     * given by a table over $[0, n)$, in $O(n)$ time
+     *
+     * Precondition: $table[i]$ is in $[0, n)$ for all i
+     *
+     * @tparam F A type for transformation
+     * @param table $f(i)$ at position i
+     * @param n The size of the domain
+     * @return eop::functional_graph<F>
+     */
+    template< transformation F >
+    eop::functional_graph<F> analyze_table(const eop::domain<F>* table, std::size_t n)
+    {
+        using D = eop::domain<F>;
+        using N = eop::distance_type<F>;
+        eop::functional_graph<F> g;
+        g.handle.assign(n, N(0));
+        g.connection.assign(n, D());
+        g.component.assign(n, 0);
+        g.cycle_size.assign(n, 0);
+        g.cycle_point.assign(n, D());
+        std::vector<std::size_t> path(n);
+        std::size_t cycles = eop::analyze_table_into<F>(table, n, g, path);
+        g.cycle_size.resize(cycles);
+        g.cycle_size.shrink_to_fit();
+        g.cycle_point.resize(cycles);
+        g.cycle_point.shrink_to_fit();
+        return g;
+    }
+
+    /**
+     * @brief A transformation on a small finite domain,
+     * replaced by a lookup table
+     *
+     * The domain is $[0, size)$ in the unsigned representation
+     * of $\func{domain}(F)$, and defaults to the whole type for
+     * types of at most 16 bits. A lazy table computes $f(x)$ on
+     * first use and is not safe to call concurrently until it
+     * has been built; an eager table is filled on construction,
+     * optionally in parallel, and is then read-only.
+     *
+     * Copies share the table, so algorithms taking the
+     * transformation by value do not copy it.
+     *
+     * Precondition: f maps the domain into itself
+     *
+     * @tparam F A type for transformation
+     */
+    template< transformation F >
+    class tabulated
+    {
+    public:
+        using D = eop::domain<F>;
+
+    private:
+        static_assert(std::is_integral_v<D> || std::is_enum_v<D>);
+
+        struct state
+        {
+            F f;
+            std::vector<D> table;
+            std::vector<unsigned char> known;
+            bool complete;
+        };
+
+        std::shared_ptr<state> _s;
+
+        static constexpr std::size_t whole_domain() noexcept
+        {
+            static_assert(sizeof(D) <= 2,
+                "the domain size is required for types wider than 16 bits");
+            return std::size_t(1) << (8 * sizeof(D));
+        }
+
+    public:
+        explicit tabulated(F f, eop::tabulation mode = eop::tabulation::lazy)
+            : tabulated(std::move(f), whole_domain(), mode) {}
+
+        tabulated(F f, std::size_t size, eop::tabulation mode = eop::tabulation::lazy)
+            : _s(std::make_shared<state>(state{ std::move(f), std::vector<D>(size),
+                std::vector<unsigned char>(size), false }))
+        {
+            if (mode == eop::tabulation::eager) build();
+        }
+
+        tabulated(F f, std::size_t size, eop::work_stealing_pool& pool)
+            : _s(std::make_shared<state>(state{ std::move(f), std::vector<D>(size),
+                std::vector<unsigned char>(size), false }))
+        {
+            build(pool);
+        }
+
+        D operator()(const D& x) const
+        {
+            std::size_t i = eop::tabulation_index(x);
+            if (!_s->complete && !_s->known[i])
+            {
+                _s->table[i] = _s->f(x);
+                _s->known[i] = 1;
+            }
+            return _s->table[i];
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _s->table.size();
+        }
+
+        bool built() const noexcept
+        {
+            return _s->complete;
+        }
+
+        const F& base() const noexcept
+        {
+            return _s->f;
+        }
+
+        /**
+         * @brief The table, valid once built
+         *
+         * @return const D*
+         */
+        const D* data() const noexcept
+        {
+            return _s->table.data();
+        }
+
+        /**
+         * @brief Computes every entry not computed yet
+         *
+         */
+        void build() const
+        {
+            state& s = *_s;
+            if (s.complete) return;
+            for (std::size_t i = 0; i < s.table.size(); ++i)
+                if (!s.known[i])
+                    s.table[i] = s.f(eop::tabulation_value<D>(i));
+            s.complete = true;
+            s.known.clear();
+            s.known.shrink_to_fit();
+        }
+
+        /**
+         * @brief Computes every entry not computed yet on a pool
+         *
+         * Precondition: f may be called concurrently
+         *
+         * @param pool The pool to run on
+         */
+        void build(eop::work_stealing_pool& pool) const
+        {
+            state& s = *_s;
+            if (s.complete) return;
+            pool.parallel_for(s.table.size(), 0, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t i = b; i < e; ++i)
+                    if (!s.known[i])
+                        s.table[i] = s.f(eop::tabulation_value<D>(i));
+            });
+            s.complete = true;
+            s.known.clear();
+            s.known.shrink_to_fit();
+        }
+
+        /**
+         * @brief Builds the table and computes the shape of every
+         * orbit in $O(size)$
+         *
+         * @return eop::functional_graph<F>
+         */
+        eop::functional_graph<F> analyze() const
+        {
+            build();
+            return eop::analyze_table<F>(data(), size());
+        }
+    };
+
+    template< transformation F >
+    struct input<eop::tabulated<F>, 0> : eop::input<F, 0> {};
+
+    template< transformation F >
+    struct output<eop::tabulated<F>> : eop::output<F> {};
+
+    template< transformation F >
+    struct distance<eop::tabulated<F>> : eop::distance<F> {};
+
+    template< transformation F >
+    struct prefetch_hint<eop::tabulated<F>>
+    {
+        static void prefetch(const eop::tabulated<F>& f, const eop::domain<F>& x) noexcept
+        {
+            eop::prefetch(f.data() + eop::tabulation_index(x));
+        }
+    };
+} // namespace eop
+
+#endif // !EOP_TABULATED_HPP
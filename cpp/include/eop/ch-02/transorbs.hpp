@@ -2,84 +2,308 @@
 #define EOP_TRANSFORMATIONS_ORBITS_HPP
 
 #include "../ch-01/founds.hpp"
+#include "../simd.hpp"
 namespace eop
 {
     /**
-     * @brief Helper function for L2 norm, computing
-     * the squared distance of the arguments
+     * @brief Computes $a b + c$, fused into one rounding when
+     * the target has a fast fused multiply-add instruction and
+     * as a multiplication and an addition otherwise, since a
+     * software fma costs far more than the rounding it saves
+     * 
+     * @tparam _Tp An arithmetic type
+     * @param a A factor
+     * @param b Another factor
+     * @param c An addend
+     * @return _Tp 
+     */
+    template< arithmetic _Tp >
+    inline
+    _Tp multiply_add(const _Tp& a, const _Tp& b, const _Tp& c) noexcept
+    {
+    #if defined(FP_FAST_FMA)
+        if constexpr (std::is_same_v<_Tp, double>) return std::fma(a, b, c);
+    #endif
+    #if defined(FP_FAST_FMAF)
+        if constexpr (std::is_same_v<_Tp, float>) return std::fma(a, b, c);
+    #endif
+        return _Tp(a * b + c);
+    }
+
+    /**
+     * @brief Kernels for the euclidean norm of a point
+     * 
+     * All of them take one square root of a sum of squares
+     * accumulated by eop::multiply_add, rather than composing
+     * binary norms by Lemma 2.1 with a root each. For a point of
+     * dimension n, with u the unit roundoff of _Tp:
+     * - fused: error at most $(n + 1) / 2$ ulp, but the squares
+     *   overflow beyond about the square root of the largest
+     *   value and lose precision below the square root of the
+     *   smallest normal one;
+     * - scaled: as fused, but when the largest magnitude is far
+     *   from 1 every coordinate is first scaled by a power of two
+     *   that brings it near 1, exactly, so neither overflow nor
+     *   underflow occur and the error bound is unchanged. This
+     *   is std::hypot's guarantee at the cost of a max and an
+     *   exponent extraction rather than a libm call; infinities
+     *   win over NaNs as with std::hypot;
+     * - widened: squares and sums are computed in
+     *   eop::norm_accumulator, e.g. double for float, so the
+     *   result is within 1 ulp, and float inputs can neither
+     *   overflow nor underflow;
+     * - approximate: the sum is multiplied by an approximate
+     *   reciprocal square root refined by Newton steps. The root
+     *   adds a relative error below $2^{-21}$ for float and
+     *   $2^{-43}$ for double on x86-64, where it is seeded by
+     *   rsqrtss, and below $2^{-17}$ and $2^{-51}$ elsewhere, to
+     *   that of the sum; only for sums in the normal range.
+     * 
+     * Integral coordinates are accumulated in _Tp, or in double
+     * when widened, and every kernel but widened then reduces to
+     * fused.
+     * 
+     */
+    enum class norm_kernel
+    {
+        fused,
+        scaled,
+        widened,
+        approximate
+    };
+
+    /**
+     * @brief The type in which the widened kernel accumulates:
+     * double for float and integral types, long double for
+     * double and long double
+     * 
+     * @tparam _Tp An arithmetic type
+     */
+    template< arithmetic _Tp >
+    using norm_accumulator = std::conditional_t<std::is_floating_point_v<_Tp>
+        && (sizeof(_Tp) > sizeof(float)), long double, double>;
+
+    /**
+     * @brief The sum of the squares of the arguments,
+     * in _Tp
      * 
      * @tparam _Tp An arithmetic type
      * @tparam Args Other arithmetic types
-     * @param x A point
-     * @param args Other points
-     * @return _Tp The squared distance
+     * @param x A coordinate
+     * @param args Other coordinates
+     * @return _Tp The squared distance from the origin
      */
     template< arithmetic _Tp, arithmetic... Args >
-    _Tp squared_distance(const _Tp& x, const Args&&... args)
+    inline
+    _Tp squared_distance(const _Tp& x, const Args&... args) noexcept
+    {
+        _Tp s = x * x;
+        ((s = eop::multiply_add(_Tp(args), _Tp(args), s)), ...);
+        return s;
+    }
+
+    /**
+     * @brief The binary exponent of a positive finite value,
+     * clamped so that both $2^e$ and $2^{-e}$ are normal
+     * 
+     * @tparam _Tp A floating-point type
+     * @param x A positive finite value
+     * @return int 
+     */
+    template< arithmetic _Tp >
+    inline
+    int norm_scale_exponent(const _Tp& x) noexcept
     {
-        static_assert(std::is_arithmetic_v<_Tp>
-            && std::is_arithmetic_v<Args...>);
-        return pow(x, 2) + squared_distance(args...);
+        using L = std::numeric_limits<_Tp>;
+        int e;
+        if constexpr (std::is_same_v<_Tp, double> && L::is_iec559)
+            e = int((std::bit_cast<std::uint64_t>(x) >> 52) & 0x7ff) - 1023;
+        else if constexpr (std::is_same_v<_Tp, float> && L::is_iec559)
+            e = int((std::bit_cast<std::uint32_t>(x) >> 23) & 0xff) - 127;
+        else
+            e = std::ilogb(x);
+        return std::clamp(e, L::min_exponent - 1, L::max_exponent - 2);
     }
 
     /**
-     * @brief Variadic template struct for euclidean (L2) norm
-     * as an n-ary operation
+     * @brief $2^e$, for an exponent returned by
+     * eop::norm_scale_exponent or its negation
+     * 
+     * @tparam _Tp A floating-point type
+     * @param e The exponent
+     * @return _Tp 
+     */
+    template< arithmetic _Tp >
+    inline
+    _Tp norm_scale(int e) noexcept
+    {
+        using L = std::numeric_limits<_Tp>;
+        if constexpr (std::is_same_v<_Tp, double> && L::is_iec559)
+            return std::bit_cast<double>(std::uint64_t(e + 1023) << 52);
+        else if constexpr (std::is_same_v<_Tp, float> && L::is_iec559)
+            return std::bit_cast<float>(std::uint32_t(e + 127) << 23);
+        else
+            return std::scalbn(_Tp(1), e);
+    }
+
+    /**
+     * @brief Approximates $1 / \sqrt{s}$, with the relative
+     * errors stated for eop::norm_kernel::approximate
+     * 
+     * Precondition: s is positive and normal
      * 
+     * @tparam _Tp A floating-point type
+     * @param s A positive value
+     * @return _Tp 
+     */
+    template< arithmetic _Tp >
+    inline
+    _Tp reciprocal_sqrt_approximate(const _Tp& s) noexcept
+    {
+        if constexpr (std::is_same_v<_Tp, float>)
+        {
+        #if defined(EOP_SIMD_X86)
+            float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(s)));
+            return r * (1.5f - 0.5f * s * r * r);
+        #else
+            float r = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<std::uint32_t>(s) >> 1));
+            for (int i = 0; i < 2; ++i) r = r * (1.5f - 0.5f * s * r * r);
+            return r;
+        #endif
+        }
+        else if constexpr (std::is_same_v<_Tp, double>)
+        {
+        #if defined(EOP_SIMD_X86)
+            using L = std::numeric_limits<float>;
+            if (s >= double(L::min()) && s <= double(L::max()))
+            {
+                double r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(float(s))));
+                for (int i = 0; i < 2; ++i) r = r * (1.5 - 0.5 * s * r * r);
+                return r;
+            }
+        #endif
+            double r = std::bit_cast<double>(
+                0x5fe6eb50c7b537a9ull - (std::bit_cast<std::uint64_t>(s) >> 1));
+            for (int i = 0; i < 4; ++i) r = r * (1.5 - 0.5 * s * r * r);
+            return r;
+        }
+        else
+            return _Tp(1) / std::sqrt(s);
+    }
+
+    /**
+     * @brief Computes the euclidean norm of a point with one
+     * of the kernels of eop::norm_kernel
+     * 
+     * @tparam K The kernel
      * @tparam _Tp An arithmetic type
-     * @tparam arity Argument count, i.e. n
      * @tparam Args Other arithmetic types
+     * @param x A coordinate
+     * @param args Other coordinates
+     * @return _Tp 
      */
-    template< arithmetic _Tp,
-              const unsigned arity,
-              arithmetic... Args >
-    struct euclidean_norm
+    template< eop::norm_kernel K, arithmetic _Tp, arithmetic... Args >
+    inline
+    _Tp norm(const _Tp& x, const Args&... args) noexcept
     {
-        inline
-        _Tp operator()(const Args&&... args) const noexcept
+        if constexpr (K == eop::norm_kernel::widened)
         {
-            static_assert(std::is_arithmetic_v<Args...>);
-            return sqrt(squared_distance(args...));
+            using W = eop::norm_accumulator<_Tp>;
+            return _Tp(std::sqrt(eop::squared_distance(W(x), W(args)...)));
         }
-    };
+        else if constexpr (!std::is_floating_point_v<_Tp>)
+            return _Tp(std::sqrt(eop::squared_distance(x, _Tp(args)...)));
+        else if constexpr (K == eop::norm_kernel::scaled)
+        {
+            using L = std::numeric_limits<_Tp>;
+            // Squares of magnitudes within 2^(+-limit) of 1 neither
+            // overflow nor lose digits to underflow
+            constexpr int limit = (L::max_exponent - L::digits) / 2;
+            // A NaN maximum gives way, so an infinity anywhere wins
+            _Tp m = std::fabs(x);
+            ((m = std::fabs(_Tp(args)) > m || m != m ? std::fabs(_Tp(args)) : m), ...);
+            if (m == L::infinity()) return m;
+            if (m == _Tp(0)) return eop::norm<eop::norm_kernel::fused>(x, args...);
+            int e = eop::norm_scale_exponent(m);
+            if (e >= -limit && e <= limit)
+                return eop::norm<eop::norm_kernel::fused>(x, args...);
+            _Tp down = eop::norm_scale<_Tp>(-e);
+            return std::sqrt(eop::squared_distance(_Tp(x * down), _Tp(_Tp(args) * down)...))
+                * eop::norm_scale<_Tp>(e);
+        }
+        else if constexpr (K == eop::norm_kernel::approximate)
+        {
+            _Tp s = eop::squared_distance(x, _Tp(args)...);
+            if (s == _Tp(0)) return s;
+            return s * eop::reciprocal_sqrt_approximate(s);
+        }
+        else
+            return std::sqrt(eop::squared_distance(x, _Tp(args)...));
+    }
+
     /**
-     * @brief Specialization of L2 norm as a binary
-     * operation
+     * @brief Euclidean (L2) norm as an n-ary operation
+     * 
+     * By Lemma 2.1 the norm of $(x_0, x_1, x_2)$ is the binary
+     * norm of the binary norm of $(x_0, x_1)$ and $x_2$, and so
+     * on; the kernels compute that value with a single square
+     * root.
      * 
      * @tparam _Tp An arithmetic type
+     * @tparam arity Argument count, i.e. n
+     * @tparam K The kernel
      */
-    template< arithmetic _Tp >
-    struct euclidean_norm<_Tp, 2>
+    template< arithmetic _Tp,
+              const unsigned arity,
+              eop::norm_kernel K = eop::norm_kernel::fused >
+    struct euclidean_norm
     {
+        template< arithmetic... Args >
+            requires (sizeof...(Args) == arity)
         inline
-        _Tp operator()(const _Tp& x0, const _Tp& x1) const noexcept
+        _Tp operator()(const Args&... args) const noexcept
         {
-            static_assert(std::is_arithmetic_v<_Tp>);
-            return sqrt(squared_distance(x0, x1));
+            return eop::norm<K>(_Tp(args)...);
         }
     };
+
     /**
-     * @brief (Lemma 2.1) Specialization of L2 norm as a
-     * ternary operation, making use of applications of the
-     * binary specialization
+     * @brief Computes the n-th power $f^n$ of a transformation
+     * with a known composition law by repeated squaring
      * 
-     * @tparam _Tp An arithmetic type
+     * Precondition: $n \geq 0$
+     * 
+     * @tparam F A composable transformation type
+     * @tparam N An integral type
+     * @param f Some composable transformation
+     * @param n The iterate number
+     * @return F 
      */
-    template< arithmetic _Tp >
-    struct euclidean_norm<_Tp, 3>
+    template< composable_transformation F, arithmetic N >
+    constexpr
+    F power_transformation(F f, N n) noexcept
     {
-        inline
-        _Tp operator()(const _Tp& x0, const _Tp& x1, const _Tp& x2) const noexcept
+        static_assert(eop::is_composable_transformation_v<F>
+            && std::is_integral_v<N>);
+        using C = eop::composition<F>;
+        F r = C::identity(f);
+        while (n != N(0))
         {
-            return eop::euclidean_norm<_Tp, 2>(eop::euclidean_norm<_Tp, 2>(x0,
-                x1), x2);
+            if (n % N(2) != N(0)) r = C::compose(r, f);
+            n = n / N(2);
+            if (n != N(0)) f = C::compose(f, f);
         }
-    };
+        return r;
+    }
 
     /**
      * @brief Computes the n-th iterate of a transformation
      * applied to some domain element
      * 
+     * If F models $\func{composable_transformation}$ and N is
+     * integral, $f^n$ is built in $O(\log n)$ compositions and
+     * applied once; otherwise f is applied n times.
+     * 
      * @tparam F A type for transformation, like a homogeneous
      * predicate or operation type
      * @tparam N An arithmetic type
@@ -93,18 +317,34 @@ namespace eop
     eop::domain<F> power_unary(eop::domain<F> x, N n, F f) noexcept
     {
         static_assert(std::is_arithmetic_v<N>);
-        while (n != N(0))
+        if constexpr (eop::is_composable_transformation_v<F>
+            && std::is_integral_v<N>)
         {
-            n = n - N(1);
-            x = f(x);
+            if (n == N(0)) return x;
+            return eop::power_transformation(f, n)(x);
+        }
+        else
+        {
+            while (n != N(0))
+            {
+                n = n - N(1);
+                x = f(x);
+            }
+            return x;
         }
-        return x;
     }
 
     /**
      * @brief Computes the minimal number of steps to transform
      * a domain element of a transformation to another one
      * 
+     * Precondition: $y$ is reachable from $x$ under $f$; use
+     * $\func{orbit_structure}$ first when this is not known
+     * 
+     * A distance type too narrow for the orbit wraps; use
+     * $\func{orbit_distance_checked}$ or
+     * $\func{orbit_distance_saturating}$ to detect overflow.
+     * 
      * @tparam F A type for transformation, like a homogeneous
      * predicate or operation type
      * @param x An element of the domain of f
@@ -118,14 +358,502 @@ namespace eop
         F f) noexcept
     {
         using N = eop::distance_type<F>;
+        using D = eop::domain<F>;
+        // For an integral N the count stays in a register. An orbit
+        // in a domain of at most 64 bits is provably shorter than
+        // 2^64 steps, and a distance type of at most 64 bits would
+        // wrap anyway; wider N carries the count once every 2^64
+        // steps. Any other N need not convert from an integer, so it
+        // is only ever incremented.
+        if constexpr (!eop::is_wide_integral_v<N>)
+        {
+            N n(0);
+            while (x != y)
+            {
+                x = f(x);
+                n = n + N(1);
+            }
+            return n;
+        }
+        else if constexpr (sizeof(N) <= sizeof(std::uint64_t)
+            || ((eop::is_wide_integral_v<D> || std::is_enum_v<D>)
+                && sizeof(D) <= sizeof(std::uint64_t)))
+        {
+            std::uint64_t k = 0;
+            while (x != y)
+            {
+                x = f(x);
+                ++k;
+            }
+            return N(k);
+        }
+        else
+        {
+            N n(0);
+            std::uint64_t k = 0;
+            while (x != y)
+            {
+                x = f(x);
+                if (++k == 0) n = n + N(~std::uint64_t(0)) + N(1);
+            }
+            return n + N(k);
+        }
+    }
+
+    /**
+     * @brief The largest value of a distance type
+     * 
+     * @tparam N An integral type
+     * @return N 
+     */
+    template< class N >
+    inline
+    constexpr
+    N distance_max() noexcept
+    {
+        if constexpr (std::numeric_limits<N>::is_specialized)
+            return std::numeric_limits<N>::max();
+        else
+        {
+            static_assert(eop::is_wide_integral_v<N>);
+            return N(~N(0));
+        }
+    }
+
+    /**
+     * @brief Computes the minimal number of steps from $x$ to
+     * $y$, or nothing if it exceeds the largest distance
+     * 
+     * The walk stops as soon as the count would overflow.
+     * 
+     * Precondition: $y$ is reachable from $x$ under $f$
+     * 
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param y Another element of the domain of f
+     * @param f Some transformation
+     * @return std::optional<eop::distance_type<F>> 
+     */
+    template< transformation F >
+    constexpr
+    std::optional<eop::distance_type<F>> orbit_distance_checked(eop::domain<F> x,
+        eop::domain<F> y, F f) noexcept
+    {
+        using N = eop::distance_type<F>;
+        if constexpr (eop::is_wide_integral_v<N> && sizeof(N) <= sizeof(std::uint64_t))
+        {
+            const std::uint64_t limit = std::uint64_t(eop::distance_max<N>());
+            std::uint64_t k = 0;
+            while (x != y)
+            {
+                if (k == limit) return std::nullopt;
+                x = f(x);
+                ++k;
+            }
+            return N(k);
+        }
+        else
+        {
+            const N limit = eop::distance_max<N>();
+            N n(0);
+            while (x != y)
+            {
+                if (n == limit) return std::nullopt;
+                x = f(x);
+                n = n + N(1);
+            }
+            return n;
+        }
+    }
+
+    /**
+     * @brief Computes the minimal number of steps from $x$ to
+     * $y$, clamped to the largest distance
+     * 
+     * A result equal to $\func{distance_max}$ reports that the
+     * true distance may be larger.
+     * 
+     * Precondition: $y$ is reachable from $x$ under $f$
+     * 
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param y Another element of the domain of f
+     * @param f Some transformation
+     * @return eop::distance_type<F> 
+     */
+    template< transformation F >
+    constexpr
+    eop::distance_type<F> orbit_distance_saturating(eop::domain<F> x,
+        eop::domain<F> y, F f) noexcept
+    {
+        using N = eop::distance_type<F>;
+        const N limit = eop::distance_max<N>();
         N n(0);
         while (x != y)
         {
             x = f(x);
-            n = n + N(1);
+            if (n != limit) n = n + N(1);
         }
         return n;
     }
+
+    /**
+     * @brief Finds the collision point of the orbit of $x$
+     * under $f$ by Floyd's slow/fast walk, in constant memory
+     * 
+     * Precondition: $p(x) \Leftrightarrow f(x)$ is defined
+     * Postcondition: the result is either the terminal element
+     * of a terminating orbit (for which $p$ fails), or the
+     * element of the cycle at which the fast walk caught up
+     * 
+     * @tparam F A type for transformation
+     * @tparam P A unary predicate type for the definition space
+     * of f
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @param p The definition-space predicate of f
+     * @return eop::domain<F> 
+     */
+    template< transformation F, unary_predicate<eop::domain<F>> P >
+    constexpr
+    eop::domain<F> collision_point(const eop::domain<F>& x, F f, P p) noexcept
+    {
+        if (!p(x)) return x;
+        eop::domain<F> slow = x;
+        eop::domain<F> fast = f(x);
+        while (fast != slow)
+        {
+            slow = f(slow);
+            if (!p(fast)) return fast;
+            fast = f(fast);
+            if (!p(fast)) return fast;
+            fast = f(fast);
+        }
+        return fast;
+    }
+
+    /**
+     * @brief Finds the collision point of an orbit known to
+     * be nonterminating, without consulting a definition-space
+     * predicate
+     * 
+     * Precondition: the orbit of $x$ under $f$ is nonterminating
+     * 
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @return eop::domain<F> 
+     */
+    template< transformation F >
+    constexpr
+    eop::domain<F> collision_point_nonterminating_orbit(const eop::domain<F>& x,
+        F f) noexcept
+    {
+        eop::domain<F> slow = x;
+        eop::domain<F> fast = f(x);
+        while (fast != slow)
+        {
+            slow = f(slow);
+            fast = f(fast);
+            fast = f(fast);
+        }
+        return fast;
+    }
+
+    /**
+     * @brief Determines whether the orbit of $x$ under $f$
+     * is terminating
+     * 
+     * Precondition: $p(x) \Leftrightarrow f(x)$ is defined
+     * 
+     * @tparam F A type for transformation
+     * @tparam P A unary predicate type for the definition space
+     * of f
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @param p The definition-space predicate of f
+     * @return bool 
+     */
+    template< transformation F, unary_predicate<eop::domain<F>> P >
+    constexpr
+    bool terminating(const eop::domain<F>& x, F f, P p) noexcept
+    {
+        return !p(eop::collision_point(x, f, p));
+    }
+
+    /**
+     * @brief Determines whether a nonterminating orbit is
+     * circular, i.e. has an empty handle
+     * 
+     * Precondition: the orbit of $x$ under $f$ is nonterminating
+     * 
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @return bool 
+     */
+    template< transformation F >
+    constexpr
+    bool circular_nonterminating_orbit(const eop::domain<F>& x, F f) noexcept
+    {
+        return x == f(eop::collision_point_nonterminating_orbit(x, f));
+    }
+
+    /**
+     * @brief Determines whether the orbit of $x$ under $f$
+     * is circular
+     * 
+     * Precondition: $p(x) \Leftrightarrow f(x)$ is defined
+     * 
+     * @tparam F A type for transformation
+     * @tparam P A unary predicate type for the definition space
+     * of f
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @param p The definition-space predicate of f
+     * @return bool 
+     */
+    template< transformation F, unary_predicate<eop::domain<F>> P >
+    constexpr
+    bool circular(const eop::domain<F>& x, F f, P p) noexcept
+    {
+        eop::domain<F> y = eop::collision_point(x, f, p);
+        return p(y) && x == f(y);
+    }
+
+    /**
+     * @brief Advances two elements in lockstep until they
+     * meet
+     * 
+     * Precondition: $(\exists n \in \func{distance_type}(F))\,
+     * n \geq 0 \wedge f^n(x_0) = f^n(x_1)$
+     * 
+     * @tparam F A type for transformation
+     * @param x0 An element of the domain of f
+     * @param x1 Another element of the domain of f
+     * @param f Some transformation
+     * @return eop::domain<F> 
+     */
+    template< transformation F >
+    constexpr
+    eop::domain<F> convergent_point(eop::domain<F> x0, eop::domain<F> x1,
+        F f) noexcept
+    {
+        while (x0 != x1)
+        {
+            x0 = f(x0);
+            x1 = f(x1);
+        }
+        return x0;
+    }
+
+    /**
+     * @brief Finds the connection point of a nonterminating
+     * orbit, i.e. the first element of its cycle
+     * 
+     * Precondition: the orbit of $x$ under $f$ is nonterminating
+     * 
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @return eop::domain<F> 
+     */
+    template< transformation F >
+    constexpr
+    eop::domain<F> connection_point_nonterminating_orbit(const eop::domain<F>& x,
+        F f) noexcept
+    {
+        return eop::convergent_point(x,
+            f(eop::collision_point_nonterminating_orbit(x, f)), f);
+    }
+
+    /**
+     * @brief Finds the connection point of the orbit of $x$
+     * under $f$, or its terminal element if the orbit is
+     * terminating
+     * 
+     * Precondition: $p(x) \Leftrightarrow f(x)$ is defined
+     * 
+     * @tparam F A type for transformation
+     * @tparam P A unary predicate type for the definition space
+     * of f
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @param p The definition-space predicate of f
+     * @return eop::domain<F> 
+     */
+    template< transformation F, unary_predicate<eop::domain<F>> P >
+    constexpr
+    eop::domain<F> connection_point(const eop::domain<F>& x, F f, P p) noexcept
+    {
+        eop::domain<F> y = eop::collision_point(x, f, p);
+        if (!p(y)) return y;
+        return eop::convergent_point(x, f(y), f);
+    }
+
+    /**
+     * @brief Alias for the shape of an orbit, $(m_0, m_1, r)$
+     * 
+     * For a terminating orbit, $m_0 = h - 1$, $m_1 = 0$ and $r$
+     * is the terminal element; otherwise $m_0 = h$, $m_1 = c - 1$
+     * and $r$ is the connection point, where $h$ and $c$ are the
+     * handle and cycle sizes.
+     * 
+     * @tparam F A type for transformation
+     */
+    template< transformation F >
+    using orbit_shape = eop::triple<eop::distance_type<F>,
+                                    eop::distance_type<F>,
+                                    eop::domain<F>>;
+
+    /**
+     * @brief Computes the shape of a nonterminating orbit
+     * by Floyd's algorithm
+     * 
+     * Precondition: the orbit of $x$ under $f$ is nonterminating
+     * 
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @return eop::orbit_shape<F> 
+     */
+    template< transformation F >
+    constexpr
+    eop::orbit_shape<F> orbit_structure_nonterminating_orbit(
+        const eop::domain<F>& x, F f) noexcept
+    {
+        eop::domain<F> y = eop::connection_point_nonterminating_orbit(x, f);
+        return { eop::orbit_distance(x, y, f),
+                 eop::orbit_distance(f(y), y, f),
+                 y };
+    }
+
+    /**
+     * @brief Computes the shape of the orbit of $x$ under
+     * $f$ by Floyd's algorithm
+     * 
+     * Precondition: $p(x) \Leftrightarrow f(x)$ is defined
+     * 
+     * @tparam F A type for transformation
+     * @tparam P A unary predicate type for the definition space
+     * of f
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @param p The definition-space predicate of f
+     * @return eop::orbit_shape<F> 
+     */
+    template< transformation F, unary_predicate<eop::domain<F>> P >
+    constexpr
+    eop::orbit_shape<F> orbit_structure(const eop::domain<F>& x, F f,
+        P p) noexcept
+    {
+        using N = eop::distance_type<F>;
+        eop::domain<F> y = eop::connection_point(x, f, p);
+        N m = eop::orbit_distance(x, y, f);
+        N n(0);
+        if (p(y)) n = eop::orbit_distance(f(y), y, f);
+        return { m, n, y };
+    }
+
+    /**
+     * @brief Computes the shape of a nonterminating orbit
+     * by Brent's algorithm
+     * 
+     * The hare teleports the tortoise to itself at every power
+     * of two, so the cycle size falls out of the first walk and
+     * only the handle needs a second one; this takes roughly a
+     * third fewer applications of $f$ than Floyd's algorithm.
+     * 
+     * Precondition: the orbit of $x$ under $f$ is nonterminating
+     * 
+     * @tparam F A type for transformation
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @return eop::orbit_shape<F> 
+     */
+    template< transformation F >
+    constexpr
+    eop::orbit_shape<F> orbit_structure_brent_nonterminating_orbit(
+        const eop::domain<F>& x, F f) noexcept
+    {
+        using N = eop::distance_type<F>;
+        N power(1);
+        N c(1);
+        eop::domain<F> slow = x;
+        eop::domain<F> fast = f(x);
+        while (fast != slow)
+        {
+            if (power == c)
+            {
+                slow = fast;
+                power = power + power;
+                c = N(0);
+            }
+            fast = f(fast);
+            c = c + N(1);
+        }
+        slow = x;
+        fast = eop::power_unary(x, c, f);
+        N h(0);
+        while (fast != slow)
+        {
+            slow = f(slow);
+            fast = f(fast);
+            h = h + N(1);
+        }
+        return { h, N(c - N(1)), slow };
+    }
+
+    /**
+     * @brief Computes the shape of the orbit of $x$ under
+     * $f$ by Brent's algorithm
+     * 
+     * Precondition: $p(x) \Leftrightarrow f(x)$ is defined
+     * 
+     * @tparam F A type for transformation
+     * @tparam P A unary predicate type for the definition space
+     * of f
+     * @param x An element of the domain of f
+     * @param f Some transformation
+     * @param p The definition-space predicate of f
+     * @return eop::orbit_shape<F> 
+     */
+    template< transformation F, unary_predicate<eop::domain<F>> P >
+    constexpr
+    eop::orbit_shape<F> orbit_structure_brent(const eop::domain<F>& x, F f,
+        P p) noexcept
+    {
+        using N = eop::distance_type<F>;
+        if (!p(x)) return { N(0), N(0), x };
+        N power(1);
+        N c(1);
+        N n(1);
+        eop::domain<F> slow = x;
+        eop::domain<F> fast = f(x);
+        while (fast != slow)
+        {
+            if (power == c)
+            {
+                slow = fast;
+                power = power + power;
+                c = N(0);
+            }
+            if (!p(fast)) return { n, N(0), fast };
+            fast = f(fast);
+            c = c + N(1);
+            n = n + N(1);
+        }
+        slow = x;
+        fast = eop::power_unary(x, c, f);
+        N h(0);
+        while (fast != slow)
+        {
+            slow = f(slow);
+            fast = f(fast);
+            h = h + N(1);
+        }
+        return { h, N(c - N(1)), slow };
+    }
 } // namespace eop
 
 #endif // !EOP_TRANSFORMATIONS_ORBITS_HPP
\ No newline at end of file
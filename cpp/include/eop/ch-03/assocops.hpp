@@ -0,0 +1,401 @@
+#ifndef EOP_ASSOCIATIVE_OPERATIONS_HPP
+#define EOP_ASSOCIATIVE_OPERATIONS_HPP
+
+#include "../ch-02/transorbs.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Computes $a^n$ for an associative operation by
+     * left-associated accumulation, $((a \circ a) \circ a) \dots$
+     * 
+     * Precondition: $n > 0$
+     * 
+     * @tparam _Tp A regular type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A binary operation type
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some associative operation
+     * @return _Tp 
+     */
+    template< regular _Tp, arithmetic N, binary_operation<_Tp> Op >
+    constexpr
+    _Tp power_left_associated(const _Tp& a, N n, Op op) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        _Tp r = a;
+        while (n != N(1))
+        {
+            r = op(r, a);
+            n = n - N(1);
+        }
+        return r;
+    }
+
+    /**
+     * @brief Computes $a^n$ for an associative operation by
+     * right-associated accumulation, $a \circ (a \circ (a \dots))$
+     * 
+     * Precondition: $n > 0$
+     * 
+     * @tparam _Tp A regular type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A binary operation type
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some associative operation
+     * @return _Tp 
+     */
+    template< regular _Tp, arithmetic N, binary_operation<_Tp> Op >
+    constexpr
+    _Tp power_right_associated(const _Tp& a, N n, Op op) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        _Tp r = a;
+        while (n != N(1))
+        {
+            r = op(a, r);
+            n = n - N(1);
+        }
+        return r;
+    }
+
+    /**
+     * @brief Computes $r \circ a^n$ for an associative operation
+     * by repeated squaring, iteratively
+     * 
+     * Precondition: $n > 0$
+     * 
+     * @tparam _Tp A regular type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A binary operation type
+     * @param r The accumulated result
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some associative operation
+     * @return _Tp 
+     */
+    template< regular _Tp, arithmetic N, binary_operation<_Tp> Op >
+    constexpr
+    _Tp power_accumulate_positive(_Tp r, _Tp a, N n, Op op) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        while (true)
+        {
+            if (n % N(2) != N(0))
+            {
+                r = op(r, a);
+                if (n == N(1)) return r;
+            }
+            n = n / N(2);
+            a = op(a, a);
+        }
+    }
+
+    /**
+     * @brief Computes $r \circ a^n$ for an associative operation,
+     * reusing caller-provided scratch storage
+     * 
+     * Here op is an in-place operation: $op(t, x, y)$ writes
+     * $x \circ y$ into $t$, which aliases neither argument, so
+     * operands owning storage (matrices, bignums) are combined
+     * into $t$ and swapped rather than reallocated on every step.
+     * 
+     * Precondition: $n > 0$
+     * 
+     * @tparam _Tp A regular, swappable type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A ternary in-place operation type
+     * @param r The accumulated result
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some in-place associative operation
+     * @param t Scratch storage for intermediate results
+     * @return _Tp& r
+     */
+    template< regular _Tp, arithmetic N, n_ary_operation<_Tp&, _Tp&, _Tp&> Op >
+    constexpr
+    _Tp& power_accumulate_positive(_Tp& r, _Tp& a, N n, Op op, _Tp& t) noexcept
+    {
+        static_assert(std::is_integral_v<N> && std::is_swappable_v<_Tp>);
+        using std::swap;
+        while (true)
+        {
+            if (n % N(2) != N(0))
+            {
+                op(t, r, a);
+                swap(r, t);
+                if (n == N(1)) return r;
+            }
+            n = n / N(2);
+            op(t, a, a);
+            swap(a, t);
+        }
+    }
+
+    /**
+     * @brief Computes $r \circ a^n$ for an associative operation
+     * 
+     * Precondition: $n \geq 0$
+     * 
+     * @tparam _Tp A regular type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A binary operation type
+     * @param r The accumulated result
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some associative operation
+     * @return _Tp 
+     */
+    template< regular _Tp, arithmetic N, binary_operation<_Tp> Op >
+    constexpr
+    _Tp power_accumulate(_Tp r, const _Tp& a, N n, Op op) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        if (n == N(0)) return r;
+        return eop::power_accumulate_positive(r, a, n, op);
+    }
+
+    /**
+     * @brief Computes $r \circ a^n$ for an associative operation,
+     * reusing caller-provided scratch storage
+     * 
+     * Precondition: $n \geq 0$
+     * 
+     * @tparam _Tp A regular, swappable type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A ternary in-place operation type
+     * @param r The accumulated result
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some in-place associative operation
+     * @param t Scratch storage for intermediate results
+     * @return _Tp& r
+     */
+    template< regular _Tp, arithmetic N, n_ary_operation<_Tp&, _Tp&, _Tp&> Op >
+    constexpr
+    _Tp& power_accumulate(_Tp& r, _Tp& a, N n, Op op, _Tp& t) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        if (n == N(0)) return r;
+        return eop::power_accumulate_positive(r, a, n, op, t);
+    }
+
+    /**
+     * @brief Computes $a^n$ for an associative operation by
+     * repeated squaring
+     * 
+     * Squares away the even part of $n$ first, so the accumulator
+     * starts from $a$ itself and no identity element is needed.
+     * 
+     * Precondition: $n > 0$
+     * 
+     * @tparam _Tp A regular type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A binary operation type
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some associative operation
+     * @return _Tp 
+     */
+    template< regular _Tp, arithmetic N, binary_operation<_Tp> Op >
+    constexpr
+    _Tp power(_Tp a, N n, Op op) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        while (n % N(2) == N(0))
+        {
+            a = op(a, a);
+            n = n / N(2);
+        }
+        n = n / N(2);
+        if (n == N(0)) return a;
+        return eop::power_accumulate_positive(a, op(a, a), n, op);
+    }
+
+    /**
+     * @brief Computes $a^n$ for an associative operation with
+     * an identity element
+     * 
+     * Precondition: $n \geq 0$
+     * 
+     * @tparam _Tp A regular type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A binary operation type
+     * @param a An element of the domain of op
+     * @param n The exponent
+     * @param op Some associative operation
+     * @param id The identity element of op
+     * @return _Tp 
+     */
+    template< regular _Tp, arithmetic N, binary_operation<_Tp> Op >
+    constexpr
+    _Tp power(const _Tp& a, N n, Op op, const _Tp& id) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        if (n == N(0)) return id;
+        return eop::power(a, n, op);
+    }
+
+    /**
+     * @brief Computes $a^n$ for an associative operation with
+     * an identity element, reusing caller-provided storage
+     * 
+     * On return $a$ holds the result; $a$ and $t$ are both used
+     * as working storage, so no operand is allocated inside the
+     * loop.
+     * 
+     * Precondition: $n \geq 0$
+     * 
+     * @tparam _Tp A regular, swappable type, the domain of op
+     * @tparam N An integral type
+     * @tparam Op A ternary in-place operation type
+     * @param a An element of the domain of op, overwritten by $a^n$
+     * @param n The exponent
+     * @param op Some in-place associative operation
+     * @param id The identity element of op
+     * @param t Scratch storage for intermediate results
+     * @return _Tp& a
+     */
+    template< regular _Tp, arithmetic N, n_ary_operation<_Tp&, _Tp&, _Tp&> Op >
+    constexpr
+    _Tp& power(_Tp& a, N n, Op op, const _Tp& id, _Tp& t) noexcept
+    {
+        static_assert(std::is_integral_v<N> && std::is_swappable_v<_Tp>);
+        using std::swap;
+        if (n == N(0))
+        {
+            a = id;
+            return a;
+        }
+        while (n % N(2) == N(0))
+        {
+            op(t, a, a);
+            swap(a, t);
+            n = n / N(2);
+        }
+        n = n / N(2);
+        if (n == N(0)) return a;
+        _Tp s = a;
+        op(t, a, a);
+        swap(a, t);
+        eop::power_accumulate_positive(s, a, n, op, t);
+        swap(a, s);
+        return a;
+    }
+
+    /**
+     * @brief Multiplication modulo a fixed modulus as a binary
+     * operation, widening the intermediate product to avoid
+     * overflow
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     */
+    template< arithmetic _Tp >
+    struct modular_multiply
+    {
+        _Tp modulus;
+
+        constexpr
+        _Tp operator()(const _Tp& x, const _Tp& y) const noexcept
+        {
+            static_assert(std::is_unsigned_v<_Tp> && sizeof(_Tp) <= 8);
+            using W = std::conditional_t<(sizeof(_Tp) < 4), std::uint_fast32_t,
+                      std::conditional_t<(sizeof(_Tp) < 8), std::uint_fast64_t,
+                                         unsigned __int128>>;
+            return _Tp(W(x) * W(y) % W(modulus));
+        }
+    };
+
+    /**
+     * @brief Computes $a^n \bmod m$
+     * 
+     * Precondition: $m > 0$
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     * @tparam N An integral type
+     * @param a The base
+     * @param n The exponent, $n \geq 0$
+     * @param m The modulus
+     * @return _Tp 
+     */
+    template< arithmetic _Tp, arithmetic N >
+    constexpr
+    _Tp power_modulo(const _Tp& a, N n, const _Tp& m) noexcept
+    {
+        return eop::power(_Tp(a % m), n, eop::modular_multiply<_Tp>{m},
+            _Tp(_Tp(1) % m));
+    }
+
+    /**
+     * @brief 2x2 matrix over an arithmetic type, as a regular
+     * type
+     * 
+     * @tparam _Tp An arithmetic type
+     */
+    template< arithmetic _Tp >
+    struct matrix_2x2
+    {
+        _Tp m00, m01, m10, m11;
+
+        friend
+        constexpr
+        bool operator==(const matrix_2x2& x, const matrix_2x2& y) noexcept
+        {
+            return x.m00 == y.m00 && x.m01 == y.m01
+                && x.m10 == y.m10 && x.m11 == y.m11;
+        }
+
+        friend
+        constexpr
+        bool operator!=(const matrix_2x2& x, const matrix_2x2& y) noexcept
+        {
+            return !(x == y);
+        }
+    };
+
+    /**
+     * @brief Multiplication of 2x2 matrices as a binary
+     * operation
+     * 
+     * @tparam _Tp An arithmetic type
+     */
+    template< arithmetic _Tp >
+    struct matrix_2x2_multiply
+    {
+        constexpr
+        eop::matrix_2x2<_Tp> operator()(const eop::matrix_2x2<_Tp>& x,
+            const eop::matrix_2x2<_Tp>& y) const noexcept
+        {
+            return { x.m00 * y.m00 + x.m01 * y.m10,
+                     x.m00 * y.m01 + x.m01 * y.m11,
+                     x.m10 * y.m00 + x.m11 * y.m10,
+                     x.m10 * y.m01 + x.m11 * y.m11 };
+        }
+    };
+
+    /**
+     * @brief Computes the n-th Fibonacci number, $F_n$, as an
+     * entry of the n-th power of the matrix
+     * $\begin{pmatrix} 1 & 1 \\ 1 & 0 \end{pmatrix}$
+     * 
+     * Precondition: $n \geq 0$ and $F_n$ is representable in _Tp
+     * 
+     * @tparam _Tp An arithmetic type
+     * @tparam N An integral type
+     * @param n The index
+     * @return _Tp 
+     */
+    template< arithmetic _Tp, arithmetic N >
+    constexpr
+    _Tp fibonacci(N n) noexcept
+    {
+        static_assert(std::is_integral_v<N>);
+        if (n == N(0)) return _Tp(0);
+        return eop::power(eop::matrix_2x2<_Tp>{ _Tp(1), _Tp(1), _Tp(1), _Tp(0) },
+            n, eop::matrix_2x2_multiply<_Tp>()).m01;
+    }
+} // namespace eop
+
+#endif // !EOP_ASSOCIATIVE_OPERATIONS_HPP
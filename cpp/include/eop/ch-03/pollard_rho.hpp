@@ -0,0 +1,318 @@
+#ifndef EOP_POLLARD_RHO_HPP
+#define EOP_POLLARD_RHO_HPP
+
+#include "assocops.hpp"
+#include "../ch-02/distinguished_points.hpp"
+
+namespace eop
+{
+    /**
+     * @brief The transformation $x \mapsto x^2 + c \bmod n$
+     * of Pollard's rho factorization
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     */
+    template< arithmetic _Tp >
+    struct square_add_modulo
+    {
+        _Tp modulus;
+        _Tp c;
+
+        constexpr
+        _Tp operator()(const _Tp& x) const noexcept
+        {
+            _Tp y = eop::modular_multiply<_Tp>{modulus}(x, x) + c;
+            return y >= modulus || y < c ? _Tp(y - modulus) : y;
+        }
+    };
+
+    template< arithmetic _Tp >
+    struct input<eop::square_add_modulo<_Tp>, 0>
+    {
+        using type = _Tp;
+    };
+
+    template< arithmetic _Tp >
+    struct distance<eop::square_add_modulo<_Tp>>
+    {
+        using type = std::uint64_t;
+    };
+
+    /**
+     * @brief Runs one Brent walk of Pollard's rho under
+     * $x \mapsto x^2 + c$, accumulating $|x - y|$ products so that
+     * a gcd is taken only once per batch
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     * @param n The number to factor
+     * @param c The additive constant of the walk
+     * @param max_steps The walk budget
+     * @param stop Set when another walk has already succeeded
+     * @return _Tp A divisor of n, which is n itself on failure
+     */
+    template< arithmetic _Tp >
+    _Tp pollard_rho_brent(const _Tp& n, const _Tp& c, std::uint64_t max_steps,
+        const std::atomic<bool>& stop) noexcept
+    {
+        constexpr std::uint64_t batch = 128;
+        eop::square_add_modulo<_Tp> f{n, _Tp(c % n)};
+        eop::modular_multiply<_Tp> mul{n};
+        _Tp y(2), x(2), ys(2), q(1), g(1);
+        std::uint64_t r = 1, steps = 0;
+        do
+        {
+            x = y;
+            y = eop::power_unary(y, r, f);
+            std::uint64_t k = 0;
+            while (k < r && g == _Tp(1))
+            {
+                ys = y;
+                std::uint64_t m = batch < r - k ? batch : r - k;
+                for (std::uint64_t i = 0; i < m; ++i)
+                {
+                    y = f(y);
+                    q = mul(q, x > y ? _Tp(x - y) : _Tp(y - x));
+                }
+                g = std::gcd(q, n);
+                k = k + m;
+                steps = steps + m;
+                if (stop.load(std::memory_order_relaxed)) return n;
+            }
+            r = r + r;
+        } while (g == _Tp(1) && steps < max_steps);
+        if (g == n)
+        {
+            do
+            {
+                ys = f(ys);
+                g = std::gcd(x > ys ? _Tp(x - ys) : _Tp(ys - x), n);
+            } while (g == _Tp(1));
+        }
+        return g == _Tp(1) ? n : g;
+    }
+
+    /**
+     * @brief Finds a nontrivial divisor of a composite number by
+     * Pollard's rho, racing walks with different constants on a
+     * pool
+     * 
+     * Colliding walks only reveal a factor modulo the unknown
+     * divisor, so the walks are independent Brent cycle searches
+     * rather than a shared distinguished-point search; the first
+     * to succeed stops the rest.
+     * 
+     * Precondition: n is composite
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     * @param n The number to factor
+     * @param pool The pool to run on
+     * @return _Tp A divisor $1 < d < n$, or n if every walk failed
+     */
+    template< arithmetic _Tp >
+    _Tp pollard_rho_factor(const _Tp& n, eop::work_stealing_pool& pool)
+    {
+        static_assert(std::is_unsigned_v<_Tp> && sizeof(_Tp) <= 8);
+        if (n % _Tp(2) == _Tp(0)) return _Tp(2);
+        std::atomic<bool> stop{false};
+        std::mutex mutex;
+        _Tp d = n;
+        pool.parallel_for(pool.size() * 64, 1, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+            {
+                if (stop.load(std::memory_order_relaxed)) return;
+                _Tp g = eop::pollard_rho_brent(n, _Tp(i + 1), std::uint64_t(1) << 26, stop);
+                if (g == n) continue;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (d == n) d = g;
+                stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+        });
+        return d;
+    }
+
+    /**
+     * @brief A group element $x = g^a h^b$ together with its
+     * exponents, compared and hashed by $x$ alone
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     */
+    template< arithmetic _Tp >
+    struct rho_log_state
+    {
+        _Tp x, a, b;
+
+        friend
+        constexpr
+        bool operator==(const rho_log_state& u, const rho_log_state& v) noexcept
+        {
+            return u.x == v.x;
+        }
+
+        friend
+        constexpr
+        bool operator!=(const rho_log_state& u, const rho_log_state& v) noexcept
+        {
+            return !(u == v);
+        }
+    };
+
+    /**
+     * @brief Mixes the bits of a 64-bit word (splitmix64
+     * finalizer)
+     * 
+     * @param z A word
+     * @return std::uint64_t 
+     */
+    constexpr
+    std::uint64_t mix64(std::uint64_t z) noexcept
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Teske's r-adding walk for discrete logarithms in
+     * the multiplicative group modulo p, with 16 multipliers
+     * $g^{a_j} h^{b_j}$ chosen by a hash of $x$
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     */
+    template< arithmetic _Tp >
+    struct rho_log_step
+    {
+        _Tp p, q;
+        eop::rho_log_state<_Tp> m[16];
+
+        rho_log_step(const _Tp& g, const _Tp& h, const _Tp& p0, const _Tp& q0,
+            std::uint64_t salt) noexcept
+            : p(p0), q(q0)
+        {
+            eop::modular_multiply<_Tp> mul{p};
+            for (std::uint64_t j = 0; j < 16; ++j)
+            {
+                _Tp a = _Tp(eop::mix64(salt * 32 + 2 * j) % q);
+                _Tp b = _Tp(eop::mix64(salt * 32 + 2 * j + 1) % q);
+                m[j] = { mul(eop::power_modulo(g, a, p), eop::power_modulo(h, b, p)), a, b };
+            }
+        }
+
+        constexpr
+        eop::rho_log_state<_Tp> operator()(const eop::rho_log_state<_Tp>& s) const noexcept
+        {
+            const eop::rho_log_state<_Tp>& t = m[eop::mix64(s.x) & 15];
+            _Tp a = s.a + t.a, b = s.b + t.b;
+            return { eop::modular_multiply<_Tp>{p}(s.x, t.x),
+                     a >= q || a < t.a ? _Tp(a - q) : a,
+                     b >= q || b < t.b ? _Tp(b - q) : b };
+        }
+    };
+
+    template< arithmetic _Tp >
+    struct input<eop::rho_log_step<_Tp>, 0>
+    {
+        using type = eop::rho_log_state<_Tp>;
+    };
+
+    template< arithmetic _Tp >
+    struct distance<eop::rho_log_step<_Tp>>
+    {
+        using type = std::uint64_t;
+    };
+
+    /**
+     * @brief Hash of a rho-log state by its group element
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     */
+    template< arithmetic _Tp >
+    struct rho_log_hash
+    {
+        std::size_t operator()(const eop::rho_log_state<_Tp>& s) const noexcept
+        {
+            return std::size_t(eop::mix64(s.x ^ 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    /**
+     * @brief Computes the discrete logarithm $k$ with $g^k = h$
+     * modulo p by Pollard's rho, using the distinguished-point
+     * collision search on a pool
+     * 
+     * A collision $g^{a_1} h^{b_1} = g^{a_2} h^{b_2}$ with
+     * $b_1 \neq b_2$ gives $k = (a_1 - a_2) / (b_2 - b_1) \bmod q$.
+     * Degenerate collisions restart the search with fresh
+     * multipliers. Orders below $2^{16}$ are searched by
+     * enumeration.
+     * 
+     * Precondition: p is prime, g has prime order q modulo p,
+     * $q < 2^{63}$ and h is in the subgroup generated by g
+     * 
+     * @tparam _Tp An unsigned integral type of at most 64 bits
+     * @param g The base
+     * @param h The power of g whose exponent is sought
+     * @param p The modulus
+     * @param q The order of g
+     * @param pool The pool to run on
+     * @return The exponent, if found within the walk budget
+     */
+    template< arithmetic _Tp >
+    std::optional<_Tp> pollard_rho_log(const _Tp& g, const _Tp& h, const _Tp& p,
+        const _Tp& q, eop::work_stealing_pool& pool)
+    {
+        static_assert(std::is_unsigned_v<_Tp> && sizeof(_Tp) <= 8);
+        using S = eop::rho_log_state<_Tp>;
+        if (h % p == _Tp(1) % p) return _Tp(0);
+        // Small groups are searched directly, which is faster than
+        // starting the walks and leaves them at least 4
+        // distinguishing bits
+        if (std::uint64_t(q) < (std::uint64_t(1) << 16))
+        {
+            eop::modular_multiply<_Tp> mul{p};
+            _Tp x = _Tp(1) % p;
+            for (_Tp k(0); k < q; k = _Tp(k + 1))
+            {
+                if (x == h % p) return k;
+                x = mul(x, _Tp(g % p));
+            }
+            return std::nullopt;
+        }
+        unsigned bits = 0;
+        while (bits < 64 && (std::uint64_t(q) >> bits) != 0) ++bits;
+        std::uint64_t dp_mask = (std::uint64_t(1) << (bits / 4)) - 1;
+        eop::distinguished_point_options options;
+        options.capacity = std::size_t(1) << 16;
+        options.max_trail = 64 * (dp_mask + 1);
+        options.max_walks = std::size_t(1) << 24;
+        for (std::uint64_t salt = 0; salt < 8; ++salt)
+        {
+            eop::rho_log_step<_Tp> f(g, h, p, q, salt);
+            eop::modular_multiply<_Tp> mul{p};
+            auto seed = [&](std::size_t i)
+            {
+                _Tp a = _Tp(eop::mix64(~(salt * 0x10000000ull + i)) % q);
+                _Tp b = _Tp(eop::mix64(salt * 0x10000000ull + i) % q);
+                return S{ mul(eop::power_modulo(g, a, p), eop::power_modulo(h, b, p)), a, b };
+            };
+            auto distinguished = [&](const S& s)
+            {
+                return (eop::mix64(s.x) >> 32 & dp_mask) == 0;
+            };
+            auto r = eop::distinguished_point_collision(f, distinguished, seed, pool,
+                options, eop::rho_log_hash<_Tp>());
+            if (!r) continue;
+            S u = f(r->m0), v = f(r->m1);
+            if (u.b == v.b) continue;
+            _Tp num = u.a >= v.a ? _Tp(u.a - v.a) : _Tp(q - (v.a - u.a));
+            _Tp den = v.b >= u.b ? _Tp(v.b - u.b) : _Tp(q - (u.b - v.b));
+            _Tp k = eop::modular_multiply<_Tp>{q}(num,
+                eop::power_modulo(den, _Tp(q - 2), q));
+            if (eop::power_modulo(g, k, p) == h % p) return k;
+        }
+        return std::nullopt;
+    }
+} // namespace eop
+
+#endif // !EOP_POLLARD_RHO_HPP
@@ -0,0 +1,550 @@
+#ifndef EOP_REDUCTIONS_HPP
+#define EOP_REDUCTIONS_HPP
+
+#include "assocops.hpp"
+#include "../executor.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Trait for binary operations that are commutative as
+     * well as associative, which lets a reduction interleave its
+     * accumulators
+     *
+     * Holds for addition, multiplication and the bitwise
+     * operations of the standard library on arithmetic types;
+     * other operations may opt in by specialization.
+     *
+     */
+    template< class Op, class _Tp >
+    struct is_commutative : std::false_type {};
+
+    template< class _Tp >
+    struct is_commutative<std::plus<_Tp>, _Tp> : std::is_arithmetic<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::plus<>, _Tp> : std::is_arithmetic<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::multiplies<_Tp>, _Tp> : std::is_arithmetic<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::multiplies<>, _Tp> : std::is_arithmetic<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::bit_and<_Tp>, _Tp> : std::is_integral<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::bit_and<>, _Tp> : std::is_integral<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::bit_or<_Tp>, _Tp> : std::is_integral<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::bit_or<>, _Tp> : std::is_integral<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::bit_xor<_Tp>, _Tp> : std::is_integral<_Tp> {};
+    template< class _Tp >
+    struct is_commutative<std::bit_xor<>, _Tp> : std::is_integral<_Tp> {};
+
+    template< class Op, class _Tp >
+    inline
+    constexpr
+    bool is_commutative_v = eop::is_commutative<Op, _Tp>::value;
+
+    /**
+     * @brief Reduces a nonempty range by left-associated
+     * accumulation, $(((x_0 \circ x_1) \circ x_2) \circ \ldots)$
+     *
+     * Precondition: $f \neq l$, and op is associative on the
+     * values of the range
+     *
+     * @tparam I An input iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param op Some associative operation
+     * @return eop::iterator_value_type<I>
+     */
+    template< iterator I, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    constexpr
+    eop::iterator_value_type<I> reduce_nonempty(I f, I l, Op op)
+    {
+        eop::iterator_value_type<I> r = *f;
+        for (++f; f != l; ++f) r = op(r, *f);
+        return r;
+    }
+
+    /**
+     * @brief Reduces the elements of a range other than z,
+     * an identity element of op, which are skipped; returns z if
+     * there are none
+     *
+     * Precondition: op is associative, and $z \circ x = x \circ z = x$
+     *
+     * @tparam I An input iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param op Some associative operation
+     * @param z The identity element of op
+     * @return eop::iterator_value_type<I>
+     */
+    template< iterator I, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    constexpr
+    eop::iterator_value_type<I> reduce_nonzeroes(I f, I l, Op op,
+        const eop::iterator_value_type<I>& z)
+    {
+        eop::iterator_value_type<I> x = z;
+        for (; f != l && x == z; ++f) x = *f;
+        for (; f != l; ++f)
+            if (*f != z) x = op(x, *f);
+        return x;
+    }
+
+    /**
+     * @brief Binary counter for balanced reduction
+     *
+     * Slot i holds the reduction of a block of $2^i$ consecutive
+     * inputs when bit i of the mask is set. Adding an input
+     * carries like binary increment: equal-sized blocks are
+     * combined, the earlier on the left, so n inputs are
+     * reduced by a tree of depth $\lceil \log_2 n \rceil$ whose
+     * shape depends only on n. With floating-point addition the
+     * error then grows with $\log n$ rather than n.
+     *
+     * No identity element is needed, since empty slots are
+     * tracked by the mask rather than by a marker value.
+     *
+     * @tparam Op A binary operation type
+     * @tparam _Tp The domain of op
+     */
+    template< class Op, class _Tp >
+    class binary_counter
+    {
+    private:
+        std::array<_Tp, 64> _slots{};
+        std::uint64_t _mask = 0;
+        Op _op;
+
+    public:
+        explicit binary_counter(Op op = Op()) : _op(op) {}
+
+        /**
+         * @brief Adds the next input
+         *
+         * @param x The input, later than all those added before
+         */
+        void add(_Tp x)
+        {
+            std::size_t i = 0;
+            while (_mask & (std::uint64_t(1) << i))
+            {
+                x = _op(_slots[i], x);
+                _mask &= ~(std::uint64_t(1) << i);
+                ++i;
+            }
+            _slots[i] = std::move(x);
+            _mask |= std::uint64_t(1) << i;
+        }
+
+        bool empty() const noexcept
+        {
+            return _mask == 0;
+        }
+
+        /**
+         * @brief The reduction of every input added, or z if
+         * there is none
+         *
+         * @param z The result for no input
+         * @return _Tp
+         */
+        _Tp reduce(const _Tp& z) const
+        {
+            if (_mask == 0) return z;
+            std::size_t i = std::size_t(std::countr_zero(_mask));
+            _Tp x = _slots[i];
+            for (std::uint64_t m = _mask & (_mask - 1); m != 0; m &= m - 1)
+                x = _op(_slots[std::size_t(std::countr_zero(m))], x);
+            return x;
+        }
+    };
+
+    /**
+     * @brief Reduces a nonempty random access range with K
+     * independent accumulators
+     *
+     * The accumulators break the dependency of each step on the
+     * last, so K operations are in flight, and the compiler can
+     * keep them in vector registers. For an operation known to be
+     * commutative (eop::is_commutative_v) accumulator j takes
+     * the elements $j, j + K, j + 2K, \ldots$, which vectorizes;
+     * otherwise it takes the j-th of K consecutive blocks, so only
+     * associativity is used. The accumulators are combined
+     * pairwise. For a given K the grouping depends only on the
+     * length of the range, so floating-point results are
+     * reproducible, though they differ from a left fold.
+     *
+     * Precondition: $f \neq l$, and op is associative on the
+     * values of the range
+     *
+     * @tparam K The number of accumulators, a power of two
+     * @tparam I A random access iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param op Some associative operation
+     * @return eop::iterator_value_type<I>
+     */
+    template< std::size_t K = 8, random_access_iterator I, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    constexpr
+    eop::iterator_value_type<I> reduce_unrolled(I f, I l, Op op)
+    {
+        static_assert(K > 0 && (K & (K - 1)) == 0);
+        using T = eop::iterator_value_type<I>;
+        std::size_t n = std::size_t(l - f);
+        if (n < 2 * K) return eop::reduce_nonempty(f, l, op);
+        std::array<T, K> acc;
+        if constexpr (eop::is_commutative_v<Op, T>)
+        {
+            for (std::size_t j = 0; j < K; ++j) acc[j] = f[j];
+            std::size_t i = K;
+            for (; i + K <= n; i += K)
+                for (std::size_t j = 0; j < K; ++j) acc[j] = op(acc[j], f[i + j]);
+            for (std::size_t j = 0; j < n - i; ++j) acc[j] = op(acc[j], f[i + j]);
+        }
+        else
+        {
+            std::size_t m = n / K;
+            for (std::size_t j = 0; j < K; ++j) acc[j] = f[j * m];
+            for (std::size_t i = 1; i < m; ++i)
+                for (std::size_t j = 0; j < K; ++j) acc[j] = op(acc[j], f[j * m + i]);
+            for (std::size_t i = K * m; i < n; ++i) acc[K - 1] = op(acc[K - 1], f[i]);
+        }
+        for (std::size_t w = 1; w < K; w += w)
+            for (std::size_t j = 0; j < K; j += w + w) acc[j] = op(acc[j], acc[j + w]);
+        return acc[0];
+    }
+
+    /**
+     * @brief Reduces a range by a balanced tree, with an
+     * eop::binary_counter; returns z if it is empty
+     *
+     * A random access range is fed to the counter in leaves of
+     * Leaf elements, each reduced by eop::reduce_unrolled, which
+     * keeps the error bound of pairwise summation, $O(Leaf + \log n)$
+     * roundings, at nearly the speed of an unrolled loop.
+     *
+     * Precondition: op is associative on the values of the range
+     *
+     * @tparam Leaf The number of elements per leaf
+     * @tparam I An input iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param op Some associative operation
+     * @param z The result for an empty range
+     * @return eop::iterator_value_type<I>
+     */
+    template< std::size_t Leaf = 64, iterator I, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    eop::iterator_value_type<I> reduce_balanced(I f, I l, Op op,
+        const eop::iterator_value_type<I>& z)
+    {
+        eop::binary_counter<Op, eop::iterator_value_type<I>> c(op);
+        if constexpr (eop::random_access_iterator<I>)
+        {
+            static_assert(Leaf > 0);
+            for (; std::size_t(l - f) > Leaf; f += Leaf)
+                c.add(eop::reduce_unrolled(f, f + Leaf, op));
+            if (f != l) c.add(eop::reduce_unrolled(f, l, op));
+        }
+        else
+            for (; f != l; ++f) c.add(*f);
+        return c.reduce(z);
+    }
+
+    /**
+     * @brief Reduces a range, or returns z if it is empty
+     *
+     * Random access ranges are reduced by
+     * eop::reduce_unrolled, others by eop::reduce_nonempty.
+     *
+     * Precondition: op is associative on the values of the range
+     *
+     * @tparam I An input iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param op Some associative operation
+     * @param z The result for an empty range
+     * @return eop::iterator_value_type<I>
+     */
+    template< iterator I, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    constexpr
+    eop::iterator_value_type<I> reduce(I f, I l, Op op,
+        const eop::iterator_value_type<I>& z)
+    {
+        if (f == l) return z;
+        if constexpr (eop::random_access_iterator<I>)
+            return eop::reduce_unrolled(f, l, op);
+        else
+            return eop::reduce_nonempty(f, l, op);
+    }
+
+    /**
+     * @brief Reduces a random access range on a pool; returns z
+     * if it is empty
+     *
+     * The range is cut into blocks of a fixed size, whatever the
+     * number of threads; each block is reduced by
+     * eop::reduce_unrolled, and the block results, in order, by
+     * an eop::binary_counter. The grouping of the operations then
+     * depends only on the length of the range and the block
+     * size, so results are bitwise reproducible across thread
+     * counts and schedules.
+     *
+     * Precondition: op is associative on the values of the range,
+     * and may be called concurrently
+     *
+     * @tparam I A random access iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param op Some associative operation
+     * @param z The result for an empty range
+     * @param pool The pool to run on
+     * @param block The number of elements per block
+     * @return eop::iterator_value_type<I>
+     */
+    template< random_access_iterator I, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    eop::iterator_value_type<I> reduce_parallel(I f, I l, Op op,
+        const eop::iterator_value_type<I>& z, eop::work_stealing_pool& pool,
+        std::size_t block = std::size_t(1) << 16)
+    {
+        using T = eop::iterator_value_type<I>;
+        std::size_t n = std::size_t(l - f);
+        if (n == 0) return z;
+        if (block == 0) block = 1;
+        std::size_t blocks = (n + block - 1) / block;
+        std::vector<T> partial(blocks);
+        pool.parallel_for(blocks, 0, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+            {
+                std::size_t lo = i * block;
+                std::size_t hi = n - lo < block ? n : lo + block;
+                partial[i] = eop::reduce_unrolled(f + lo, f + hi, op);
+            }
+        });
+        return eop::reduce_balanced(partial.begin(), partial.end(), op, z);
+    }
+
+    /**
+     * @brief Reduces a random access range on the default pool
+     *
+     * @tparam I A random access iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param op Some associative operation
+     * @param z The result for an empty range
+     * @return eop::iterator_value_type<I>
+     */
+    template< random_access_iterator I, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    eop::iterator_value_type<I> reduce_parallel(I f, I l, Op op,
+        const eop::iterator_value_type<I>& z)
+    {
+        return eop::reduce_parallel(f, l, op, z, eop::default_pool());
+    }
+
+    /**
+     * @brief Writes the inclusive prefix reductions of a range,
+     * $x_0, x_0 \circ x_1, \ldots$
+     *
+     * d may be f, to scan in place.
+     *
+     * @tparam I An input iterator type
+     * @tparam O An output iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param d The first output position
+     * @param op Some associative operation
+     * @return O Past the last output position
+     */
+    template< iterator I, iterator O, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    constexpr
+    O inclusive_scan(I f, I l, O d, Op op)
+    {
+        if (f == l) return d;
+        eop::iterator_value_type<I> x = *f;
+        *d = x;
+        for (++f, ++d; f != l; ++f, ++d)
+        {
+            x = op(x, *f);
+            *d = x;
+        }
+        return d;
+    }
+
+    /**
+     * @brief Writes the exclusive prefix reductions of a range
+     * started from z, $z, z \circ x_0, z \circ x_0 \circ x_1, \ldots$
+     *
+     * d may be f, to scan in place.
+     *
+     * @tparam I An input iterator type
+     * @tparam O An output iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param d The first output position
+     * @param op Some associative operation
+     * @param z The first output, usually an identity of op
+     * @return O Past the last output position
+     */
+    template< iterator I, iterator O, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    constexpr
+    O exclusive_scan(I f, I l, O d, Op op, eop::iterator_value_type<I> z)
+    {
+        for (; f != l; ++f, ++d)
+        {
+            eop::iterator_value_type<I> y = *f;
+            *d = z;
+            z = op(z, y);
+        }
+        return d;
+    }
+
+    /**
+     * @brief Scans a random access range on a pool in blocks of
+     * a fixed size, as eop::inclusive_scan if inclusive and
+     * eop::exclusive_scan from z otherwise
+     *
+     * Each block is reduced; the block reductions are scanned in
+     * order to give each block its carry; then each block is
+     * scanned from its carry. Block boundaries do not depend on
+     * the number of threads, so the results are reproducible
+     * across thread counts.
+     *
+     */
+    template< bool Inclusive, random_access_iterator I, random_access_iterator O, class Op >
+    O scan_parallel(I f, I l, O d, Op op, const eop::iterator_value_type<I>& z,
+        eop::work_stealing_pool& pool, std::size_t block)
+    {
+        using T = eop::iterator_value_type<I>;
+        std::size_t n = std::size_t(l - f);
+        if (n == 0) return d;
+        if (block == 0) block = 1;
+        std::size_t blocks = (n + block - 1) / block;
+        auto bounds = [&](std::size_t i)
+        {
+            std::size_t lo = i * block;
+            return std::pair<std::size_t, std::size_t>(lo, n - lo < block ? n : lo + block);
+        };
+        std::vector<T> carry(blocks);
+        pool.parallel_for(blocks - 1, 0, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+            {
+                auto [lo, hi] = bounds(i);
+                carry[i + 1] = eop::reduce_nonempty(f + lo, f + hi, op);
+            }
+        });
+        // carry[i] becomes the reduction of everything before block i
+        if constexpr (Inclusive)
+        {
+            if (blocks > 1)
+                eop::inclusive_scan(carry.begin() + 1, carry.end(), carry.begin() + 1, op);
+        }
+        else
+        {
+            carry[0] = z;
+            eop::inclusive_scan(carry.begin(), carry.end(), carry.begin(), op);
+        }
+        pool.parallel_for(blocks, 0, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+            {
+                auto [lo, hi] = bounds(i);
+                if constexpr (Inclusive)
+                {
+                    if (i == 0)
+                    {
+                        eop::inclusive_scan(f + lo, f + hi, d + lo, op);
+                        continue;
+                    }
+                    T x = carry[i];
+                    for (std::size_t k = lo; k < hi; ++k)
+                    {
+                        x = op(x, f[k]);
+                        d[k] = x;
+                    }
+                }
+                else
+                    eop::exclusive_scan(f + lo, f + hi, d + lo, op, T(carry[i]));
+            }
+        });
+        return d + n;
+    }
+
+    /**
+     * @brief Writes the inclusive prefix reductions of a random
+     * access range, in parallel and reproducibly
+     *
+     * Precondition: op is associative and may be called
+     * concurrently; $[d, d + (l - f))$ is $[f, l)$ or does not
+     * overlap it
+     *
+     * @tparam I A random access iterator type
+     * @tparam O A random access iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param d The first output position
+     * @param op Some associative operation
+     * @param pool The pool to run on
+     * @param block The number of elements per block
+     * @return O Past the last output position
+     */
+    template< random_access_iterator I, random_access_iterator O, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    O inclusive_scan_parallel(I f, I l, O d, Op op, eop::work_stealing_pool& pool,
+        std::size_t block = std::size_t(1) << 16)
+    {
+        if (f == l) return d;
+        return eop::scan_parallel<true>(f, l, d, op, eop::iterator_value_type<I>(*f),
+            pool, block);
+    }
+
+    /**
+     * @brief Writes the exclusive prefix reductions of a random
+     * access range from z, in parallel and reproducibly
+     *
+     * Precondition: as for eop::inclusive_scan_parallel
+     *
+     * @tparam I A random access iterator type
+     * @tparam O A random access iterator type
+     * @tparam Op A binary operation type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param d The first output position
+     * @param op Some associative operation
+     * @param z The first output, usually an identity of op
+     * @param pool The pool to run on
+     * @param block The number of elements per block
+     * @return O Past the last output position
+     */
+    template< random_access_iterator I, random_access_iterator O, class Op >
+        requires eop::binary_operation<Op, eop::iterator_value_type<I>>
+    O exclusive_scan_parallel(I f, I l, O d, Op op, const eop::iterator_value_type<I>& z,
+        eop::work_stealing_pool& pool, std::size_t block = std::size_t(1) << 16)
+    {
+        return eop::scan_parallel<false>(f, l, d, op, z, pool, block);
+    }
+} // namespace eop
+
+#endif // !EOP_REDUCTIONS_HPP
@@ -0,0 +1,512 @@
+#ifndef EOP_REARRANGEMENTS_HPP
+#define EOP_REARRANGEMENTS_HPP
+
+#include "../intrinsics.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Objects constructed in the raw memory of a buffer,
+     * $[first, last)$, destroyed when it goes out of scope
+     *
+     * Keeps the algorithms below that move elements through a
+     * buffer from leaking them when a move throws.
+     *
+     * @tparam _Tp The object type
+     */
+    template< class _Tp >
+    struct constructed_range
+    {
+        _Tp* first;
+        _Tp* last;
+
+        constructed_range(_Tp* f, _Tp* l) noexcept : first(f), last(l) {}
+
+        constructed_range(const constructed_range&) = delete;
+        constructed_range &operator=(const constructed_range&) = delete;
+
+        ~constructed_range()
+        {
+            eop::destruct_range(first, last);
+        }
+    };
+
+    /**
+     * @brief Exchanges the elements of $[f_0, l_0)$ with those of
+     * the range starting at $f_1$
+     *
+     * Precondition: the ranges are of equal length, and do not
+     * overlap
+     *
+     * @tparam I0 A forward iterator type
+     * @tparam I1 A forward iterator type
+     * @param f0 The first position of the first range
+     * @param l0 Past the last position of the first range
+     * @param f1 The first position of the second range
+     * @return I1 Past the last position of the second range
+     */
+    template< forward_iterator I0, forward_iterator I1 >
+    I1 swap_ranges(I0 f0, I0 l0, I1 f1)
+    {
+        for (; f0 != l0; ++f0, ++f1) std::iter_swap(f0, f1);
+        return f1;
+    }
+
+    /**
+     * @brief Exchanges n elements starting at $f_0$ with n
+     * elements starting at $f_1$
+     *
+     * @tparam I0 A forward iterator type
+     * @tparam I1 A forward iterator type
+     * @param f0 The first position of the first range
+     * @param f1 The first position of the second range
+     * @param n The number of elements
+     * @return std::pair<I0, I1> Past the last positions
+     */
+    template< forward_iterator I0, forward_iterator I1 >
+    std::pair<I0, I1> swap_ranges_n(I0 f0, I1 f1, eop::iterator_difference_type<I0> n)
+    {
+        for (; n != 0; --n, ++f0, ++f1) std::iter_swap(f0, f1);
+        return { f0, f1 };
+    }
+
+    /**
+     * @brief Reverses a range by exchanging from both ends
+     *
+     * Two sequential streams, one running backward, which the
+     * hardware prefetchers follow, so it runs at memory speed on
+     * ranges of any size.
+     *
+     * @tparam I A bidirectional iterator type
+     * @param f The first position
+     * @param l Past the last position
+     */
+    template< bidirectional_iterator I >
+    void reverse_bidirectional(I f, I l)
+    {
+        while (f != l && f != --l)
+        {
+            std::iter_swap(f, l);
+            ++f;
+        }
+    }
+
+    /**
+     * @brief Reverses n elements with forward iterators only,
+     * in place, by reversing each half and exchanging the halves
+     *
+     * $n \log_2 n / 2$ exchanges. The recursion is cache
+     * oblivious: below the size of any level of the cache, every
+     * subproblem runs within it.
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param n The number of elements
+     * @return I Past the last position
+     */
+    template< forward_iterator I >
+    I reverse_n_forward(I f, eop::iterator_difference_type<I> n)
+    {
+        using N = eop::iterator_difference_type<I>;
+        if (n < N(2)) return std::next(f, n);
+        N h = n / N(2);
+        I m = std::next(eop::reverse_n_forward(f, h), n - N(2) * h);
+        I l = eop::reverse_n_forward(m, h);
+        eop::swap_ranges_n(f, m, h);
+        return l;
+    }
+
+    /**
+     * @brief Reverses n elements by moving them into a buffer and
+     * back in reverse order
+     *
+     * Precondition: fb is raw memory for at least n objects
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param n The number of elements
+     * @param fb The first position of the buffer
+     * @return I Past the last position
+     */
+    template< forward_iterator I >
+    I reverse_n_with_buffer(I f, eop::iterator_difference_type<I> n,
+        eop::iterator_value_type<I>* fb)
+    {
+        using T = eop::iterator_value_type<I>;
+        auto [l, lb] = std::uninitialized_move_n(f, n, fb);
+        eop::constructed_range<T> b(fb, lb);
+        std::move(std::reverse_iterator<T*>(lb), std::reverse_iterator<T*>(fb), f);
+        return l;
+    }
+
+    /**
+     * @brief Reverses n elements with forward iterators only,
+     * using as much of a buffer as there is
+     *
+     * Subranges that fit the buffer are reversed through it in
+     * linear time; larger ones are halved as in
+     * eop::reverse_n_forward, so $n \log_2 (n / n_b)$ exchanges in
+     * all.
+     *
+     * Precondition: fb is raw memory for at least nb objects
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param n The number of elements
+     * @param fb The first position of the buffer
+     * @param nb The size of the buffer
+     * @return I Past the last position
+     */
+    template< forward_iterator I >
+    I reverse_n_adaptive(I f, eop::iterator_difference_type<I> n,
+        eop::iterator_value_type<I>* fb, eop::iterator_difference_type<I> nb)
+    {
+        using N = eop::iterator_difference_type<I>;
+        if (n < N(2)) return std::next(f, n);
+        if (n <= nb) return eop::reverse_n_with_buffer(f, n, fb);
+        N h = n / N(2);
+        I m = std::next(eop::reverse_n_adaptive(f, h, fb, nb), n - N(2) * h);
+        I l = eop::reverse_n_adaptive(m, h, fb, nb);
+        eop::swap_ranges_n(f, m, h);
+        return l;
+    }
+
+    /**
+     * @brief Reverses a range
+     *
+     * Bidirectional ranges are reversed in place by
+     * eop::reverse_bidirectional; forward ones by
+     * eop::reverse_n_adaptive, with a eop::temporary_buffer of up
+     * to the length of the range.
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param l Past the last position
+     */
+    template< forward_iterator I >
+    void reverse(I f, I l)
+    {
+        if constexpr (eop::bidirectional_iterator<I>)
+            eop::reverse_bidirectional(f, l);
+        else
+        {
+            using N = eop::iterator_difference_type<I>;
+            N n = std::distance(f, l);
+            eop::temporary_buffer<eop::iterator_value_type<I>> b{ std::size_t(n) };
+            eop::reverse_n_adaptive(f, n, b.data(), N(b.size()));
+        }
+    }
+
+    /**
+     * @brief Rotates a random access range by following the
+     * $\gcd(n, k)$ cycles of the rotation permutation
+     *
+     * One move per element, the fewest of any rotation, but each
+     * step of a cycle jumps k elements ahead, so once the range
+     * outgrows the cache nearly every move misses.
+     *
+     * Precondition: $f \neq m \wedge m \neq l$
+     *
+     * @tparam I A random access iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @return I The new position of $*f$
+     */
+    template< random_access_iterator I >
+    I rotate_cycles(I f, I m, I l)
+    {
+        using N = eop::iterator_difference_type<I>;
+        using T = eop::iterator_value_type<I>;
+        N n = l - f;
+        N k = m - f;
+        if (k == n - k)
+        {
+            eop::swap_ranges(f, m, m);
+            return m;
+        }
+        N d = std::gcd(n, k);
+        for (N i = 0; i < d; ++i)
+        {
+            T x = std::move(f[i]);
+            N j = i;
+            for (;;)
+            {
+                N s = j < n - k ? j + k : j - (n - k);
+                if (s == i) break;
+                f[j] = std::move(f[s]);
+                j = s;
+            }
+            f[j] = std::move(x);
+        }
+        return f + (n - k);
+    }
+
+    /**
+     * @brief Rotates a bidirectional range by three reversals
+     *
+     * Both parts are reversed, then the whole range; the last
+     * reversal stops exchanging at m to locate the new position
+     * of $*f$ without counting. n exchanges, all in sequential
+     * streams.
+     *
+     * Precondition: $f \neq m \wedge m \neq l$
+     *
+     * @tparam I A bidirectional iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @return I The new position of $*f$
+     */
+    template< bidirectional_iterator I >
+    I rotate_bidirectional_nontrivial(I f, I m, I l)
+    {
+        eop::reverse_bidirectional(f, m);
+        eop::reverse_bidirectional(m, l);
+        while (f != m && l != m)
+        {
+            --l;
+            std::iter_swap(f, l);
+            ++f;
+        }
+        eop::reverse_bidirectional(f, l);
+        return f == m ? l : f;
+    }
+
+    /**
+     * @brief One round of eop::rotate_forward_nontrivial:
+     * exchanges $[f, m)$ forward through $[m, l)$, leaving f past
+     * the elements now in place and m at the start of what is
+     * left to rotate
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     */
+    template< forward_iterator I >
+    void rotate_forward_step(I& f, I& m, I l)
+    {
+        I c = m;
+        do
+        {
+            std::iter_swap(f, c);
+            ++f;
+            ++c;
+            if (f == m) m = c;
+        } while (c != l);
+    }
+
+    /**
+     * @brief Rotates a forward range by block swaps (Gries and
+     * Mills)
+     *
+     * At most n exchanges, in two streams a fixed distance apart
+     * within each round, so it keeps the sequential access of
+     * the three reversals with forward iterators only.
+     *
+     * Precondition: $f \neq m \wedge m \neq l$
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @return I The new position of $*f$
+     */
+    template< forward_iterator I >
+    I rotate_forward_nontrivial(I f, I m, I l)
+    {
+        eop::rotate_forward_step(f, m, l);
+        I r = f;
+        while (m != l) eop::rotate_forward_step(f, m, l);
+        return r;
+    }
+
+    /**
+     * @brief Rotates a range by moving $[f, m)$ into a buffer
+     *
+     * n moves, each element once, in sequential streams.
+     *
+     * Precondition: $f \neq m \wedge m \neq l$, and fb is raw
+     * memory for at least $m - f$ objects
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @param fb The first position of the buffer
+     * @return I The new position of $*f$
+     */
+    template< forward_iterator I >
+    I rotate_with_buffer_nontrivial(I f, I m, I l, eop::iterator_value_type<I>* fb)
+    {
+        using T = eop::iterator_value_type<I>;
+        eop::constructed_range<T> b(fb, std::uninitialized_move(f, m, fb));
+        I r = std::move(m, l, f);
+        std::move(b.first, b.last, r);
+        return r;
+    }
+
+    /**
+     * @brief Rotates a range by moving $[m, l)$ into a buffer
+     *
+     * Precondition: $f \neq m \wedge m \neq l$, and fb is raw
+     * memory for at least $l - m$ objects
+     *
+     * @tparam I A bidirectional iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @param fb The first position of the buffer
+     * @return I The new position of $*f$
+     */
+    template< bidirectional_iterator I >
+    I rotate_with_buffer_backward_nontrivial(I f, I m, I l,
+        eop::iterator_value_type<I>* fb)
+    {
+        using T = eop::iterator_value_type<I>;
+        eop::constructed_range<T> b(fb, std::uninitialized_move(m, l, fb));
+        I r = std::move_backward(f, m, l);
+        std::move(b.first, b.last, f);
+        return r;
+    }
+
+    /**
+     * @brief Rotates a random access range by block swaps,
+     * exchanging whole blocks of $\min(m - f, l - m)$ elements
+     *
+     * The exchanges of eop::rotate_forward_nontrivial, grouped
+     * by round: knowing the lengths, each round is one
+     * eop::swap_ranges between two blocks, a tight loop without
+     * the test for the end of the first block on every exchange.
+     *
+     * Precondition: $f \neq m \wedge m \neq l$
+     *
+     * @tparam I A random access iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @return I The new position of $*f$
+     */
+    template< random_access_iterator I >
+    I rotate_block_swaps(I f, I m, I l)
+    {
+        I r = f + (l - m);
+        while (m != l)
+        {
+            auto a = m - f;
+            auto b = l - m;
+            auto s = a < b ? a : b;
+            eop::swap_ranges(f, f + s, m);
+            f = f + s;
+            if (f == m) m = m + s;
+        }
+        return r;
+    }
+
+    /**
+     * @brief Rotates a range in place, with the algorithm suited
+     * to its iterator category
+     *
+     * Random access and forward ranges take block swaps, and
+     * bidirectional ones three reversals: all of them run in
+     * sequential streams, so they keep pace with memory on ranges
+     * far larger than the cache, where eop::rotate_cycles misses
+     * on nearly every move.
+     *
+     * Precondition: $f \neq m \wedge m \neq l$
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @return I The new position of $*f$
+     */
+    template< forward_iterator I >
+    I rotate_nontrivial(I f, I m, I l)
+    {
+        if constexpr (eop::random_access_iterator<I>)
+            return eop::rotate_block_swaps(f, m, l);
+        else if constexpr (eop::bidirectional_iterator<I>)
+            return eop::rotate_bidirectional_nontrivial(f, m, l);
+        else
+            return eop::rotate_forward_nontrivial(f, m, l);
+    }
+
+    /**
+     * @brief Rotates a range, moving $*m$ to f and $*f$ to
+     * $f + (l - m)$
+     *
+     * On a random access range whose shorter part fits in a few
+     * kilobytes, that part goes through a block on the stack,
+     * moving each element once; otherwise the range is rotated in
+     * place by eop::rotate_nontrivial.
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @return I The new position of $*f$
+     */
+    template< forward_iterator I >
+    I rotate(I f, I m, I l)
+    {
+        if (m == f) return l;
+        if (m == l) return f;
+        if constexpr (eop::random_access_iterator<I>)
+        {
+            using T = eop::iterator_value_type<I>;
+            constexpr std::size_t nb = 4096 / sizeof(T);
+            if constexpr (nb >= 8)
+            {
+                if (std::size_t(m - f) <= nb)
+                {
+                    alignas(T) std::byte b[nb * sizeof(T)];
+                    return eop::rotate_with_buffer_nontrivial(f, m, l, reinterpret_cast<T*>(b));
+                }
+                if (std::size_t(l - m) <= nb)
+                {
+                    alignas(T) std::byte b[nb * sizeof(T)];
+                    return eop::rotate_with_buffer_backward_nontrivial(f, m, l,
+                        reinterpret_cast<T*>(b));
+                }
+            }
+        }
+        return eop::rotate_nontrivial(f, m, l);
+    }
+
+    /**
+     * @brief Rotates a range, through a buffer when the shorter
+     * part fits in it and in place otherwise
+     *
+     * With forward iterators only $[f, m)$ can go through the
+     * buffer.
+     *
+     * Precondition: fb is raw memory for at least nb objects
+     *
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param m The element to move to f
+     * @param l Past the last position
+     * @param fb The first position of the buffer
+     * @param nb The size of the buffer
+     * @return I The new position of $*f$
+     */
+    template< forward_iterator I >
+    I rotate_adaptive(I f, I m, I l, eop::iterator_value_type<I>* fb,
+        eop::iterator_difference_type<I> nb)
+    {
+        if (m == f) return l;
+        if (m == l) return f;
+        auto k = std::distance(f, m);
+        auto n_k = std::distance(m, l);
+        if (k <= n_k && k <= nb)
+            return eop::rotate_with_buffer_nontrivial(f, m, l, fb);
+        if constexpr (eop::bidirectional_iterator<I>)
+            if (n_k <= nb)
+                return eop::rotate_with_buffer_backward_nontrivial(f, m, l, fb);
+        return eop::rotate_nontrivial(f, m, l);
+    }
+} // namespace eop
+
+#endif // !EOP_REARRANGEMENTS_HPP
@@ -0,0 +1,182 @@
+#ifndef EOP_PARTITIONS_HPP
+#define EOP_PARTITIONS_HPP
+
+#include "../ch-10/rearrangements.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Stable partition of n elements through a buffer:
+     * those not satisfying p are moved down in place, those
+     * satisfying it into the buffer and then after them
+     *
+     * As everywhere in this chapter, a range is partitioned when
+     * the elements not satisfying p precede those that do, the
+     * opposite of std::stable_partition. One pass over the range
+     * and one over the buffer.
+     *
+     * Precondition: fb is raw memory for at least n objects
+     *
+     * @tparam I A forward iterator type
+     * @tparam P A unary predicate type on the value type
+     * @param f The first position
+     * @param n The number of elements
+     * @param p Some predicate
+     * @param fb The first position of the buffer
+     * @return std::pair<I, I> The partition point and past the
+     * last position
+     */
+    template< forward_iterator I, unary_predicate<eop::iterator_value_type<I>> P >
+    std::pair<I, I> partition_stable_with_buffer_n(I f,
+        eop::iterator_difference_type<I> n, P p, eop::iterator_value_type<I>* fb)
+    {
+        using T = eop::iterator_value_type<I>;
+        for (; n != 0 && !p(*f); --n) ++f;
+        I x = f;
+        eop::constructed_range<T> b(fb, fb);
+        for (; n != 0; --n, ++f)
+        {
+            if (p(*f))
+            {
+                ::new (static_cast<void*>(b.last)) T(std::move(*f));
+                ++b.last;
+            }
+            else
+            {
+                *x = std::move(*f);
+                ++x;
+            }
+        }
+        std::move(b.first, b.last, x);
+        return { x, f };
+    }
+
+    /**
+     * @brief Stable partition of the one element at f
+     *
+     * @tparam I A forward iterator type
+     * @tparam P A unary predicate type on the value type
+     * @param f The position of the element
+     * @param p Some predicate
+     * @return std::pair<I, I> The partition point and past f
+     */
+    template< forward_iterator I, unary_predicate<eop::iterator_value_type<I>> P >
+    std::pair<I, I> partition_stable_singleton(I f, P p)
+    {
+        I l = std::next(f);
+        if (!p(*f)) f = l;
+        return { f, l };
+    }
+
+    /**
+     * @brief Combines two adjacent partitioned ranges, given
+     * as (partition point, past the last position), by rotating
+     * the elements satisfying p in the first past those not
+     * satisfying it in the second
+     *
+     * Precondition: fb is raw memory for at least nb objects
+     *
+     * @tparam I A forward iterator type
+     * @param x The first range
+     * @param y The second range, starting at $x.second$
+     * @param fb The first position of the buffer
+     * @param nb The size of the buffer
+     * @return std::pair<I, I> The partition point and past the
+     * last position of the combined range
+     */
+    template< forward_iterator I >
+    std::pair<I, I> combine_ranges_adaptive(const std::pair<I, I>& x,
+        const std::pair<I, I>& y, eop::iterator_value_type<I>* fb,
+        eop::iterator_difference_type<I> nb)
+    {
+        return { eop::rotate_adaptive(x.first, x.second, y.first, fb, nb), y.second };
+    }
+
+    /**
+     * @brief Stable partition of n elements using as much of a
+     * buffer as there is
+     *
+     * Subranges that fit the buffer are partitioned through it
+     * in one pass; larger ones are halved, and the partitioned
+     * halves combined by eop::rotate_adaptive. With no buffer
+     * this is the in-place divide and conquer, $O(n \log n)$
+     * exchanges; each halving of the buffer adds one level of
+     * rotations, each a sequential pass. Like any divide and
+     * conquer it is cache oblivious.
+     *
+     * Precondition: fb is raw memory for at least nb objects
+     *
+     * @tparam I A forward iterator type
+     * @tparam P A unary predicate type on the value type
+     * @param f The first position
+     * @param n The number of elements
+     * @param p Some predicate
+     * @param fb The first position of the buffer
+     * @param nb The size of the buffer
+     * @return std::pair<I, I> The partition point and past the
+     * last position
+     */
+    template< forward_iterator I, unary_predicate<eop::iterator_value_type<I>> P >
+    std::pair<I, I> partition_stable_n_adaptive(I f, eop::iterator_difference_type<I> n,
+        P p, eop::iterator_value_type<I>* fb, eop::iterator_difference_type<I> nb)
+    {
+        using N = eop::iterator_difference_type<I>;
+        if (n == N(0)) return { f, f };
+        if (n == N(1)) return eop::partition_stable_singleton(f, p);
+        if (n <= nb) return eop::partition_stable_with_buffer_n(f, n, p, fb);
+        N h = n / N(2);
+        std::pair<I, I> x = eop::partition_stable_n_adaptive(f, h, p, fb, nb);
+        std::pair<I, I> y = eop::partition_stable_n_adaptive(x.second, n - h, p, fb, nb);
+        return eop::combine_ranges_adaptive(x, y, fb, nb);
+    }
+
+    /**
+     * @brief Stable partition of n elements in place, with no
+     * buffer
+     *
+     * @tparam I A forward iterator type
+     * @tparam P A unary predicate type on the value type
+     * @param f The first position
+     * @param n The number of elements
+     * @param p Some predicate
+     * @return std::pair<I, I> The partition point and past the
+     * last position
+     */
+    template< forward_iterator I, unary_predicate<eop::iterator_value_type<I>> P >
+    std::pair<I, I> partition_stable_n(I f, eop::iterator_difference_type<I> n, P p)
+    {
+        return eop::partition_stable_n_adaptive(f, n, p,
+            static_cast<eop::iterator_value_type<I>*>(nullptr),
+            eop::iterator_difference_type<I>(0));
+    }
+
+    /**
+     * @brief Partitions a range stably, the elements not
+     * satisfying p first
+     *
+     * Runs eop::partition_stable_n_adaptive with a
+     * eop::temporary_buffer of up to the length of the range, so
+     * in one pass when the memory is there, degrading gracefully
+     * to in place when it is not.
+     *
+     * @tparam I A forward iterator type
+     * @tparam P A unary predicate type on the value type
+     * @param f The first position
+     * @param l Past the last position
+     * @param p Some predicate
+     * @return I The partition point
+     */
+    template< forward_iterator I, unary_predicate<eop::iterator_value_type<I>> P >
+    I partition_stable(I f, I l, P p)
+    {
+        using N = eop::iterator_difference_type<I>;
+        // Leading elements already in place need no buffer
+        for (; f != l && !p(*f); ++f) {}
+        if (f == l) return f;
+        N n = std::distance(f, l);
+        eop::temporary_buffer<eop::iterator_value_type<I>> b{ std::size_t(n) };
+        return eop::partition_stable_n_adaptive(f, n, p, b.data(), N(b.size())).first;
+    }
+} // namespace eop
+
+#endif // !EOP_PARTITIONS_HPP
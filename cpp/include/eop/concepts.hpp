@@ -10,12 +10,23 @@ namespace eop
      * type construction, destruction, and assignment
      * 
      */
-    #define constructible typename
-    #define destructible typename
-    #define copy_constructible typename
-    #define copy_assignable typename
-    #define move_constructible typename
-    #define move_assignable typename
+    template< class _Tp >
+    concept destructible = std::destructible<_Tp>;
+
+    template< class _Tp >
+    concept constructible = std::is_object_v<_Tp> && eop::destructible<_Tp>;
+
+    template< class _Tp >
+    concept copy_constructible = std::copy_constructible<_Tp>;
+
+    template< class _Tp >
+    concept copy_assignable = std::is_copy_assignable_v<_Tp>;
+
+    template< class _Tp >
+    concept move_constructible = std::move_constructible<_Tp>;
+
+    template< class _Tp >
+    concept move_assignable = std::is_move_assignable_v<_Tp>;
 
     /**
      * @brief Concept for an object type of
@@ -23,14 +34,19 @@ namespace eop
      * 
      * partially_formed = move_assignable + destructible
      * 
+     * References stand for their referred type, so that
+     * forwarded argument packs may be constrained.
+     * 
      */
-    #define partially_formed typename
     template< class _Tp >
     inline
     constexpr
     bool is_partially_formed_v =
         std::is_move_assignable_v<_Tp>
         && std::is_destructible_v<_Tp>;
+
+    template< class _Tp >
+    concept partially_formed = eop::is_partially_formed_v<std::remove_cvref_t<_Tp>>;
     
     /**
      * @brief Concept for an object type of
@@ -39,17 +55,18 @@ namespace eop
      * well_formed = partially_formed + ...
      * 
      */
-    #define well_formed typename
+    template< class _Tp >
+    concept well_formed = eop::partially_formed<_Tp>;
     
     /**
-     * @brief Naive implementation for nothrow
-     * convertible type checking
+     * @brief Nothrow convertible type checking, i.e.
+     * std::is_nothrow_convertible
      * 
      * @tparam From 
      * @tparam To 
      */
     template< class From, class To >
-    struct is_nothrow_convertible : std::conjunction<std::is_void<From>, std::is_void<To>> {};
+    struct is_nothrow_convertible : std::is_nothrow_convertible<From, To> {};
     
     /**
      * @brief Variable helper method for nothrow
@@ -69,7 +86,7 @@ namespace eop
     bool linear_usable_as_v =
         std::is_nothrow_constructible_v<_Tp, U> &&
         std::is_nothrow_assignable_v<_Tp&, U> &&
-        eop::is_nothrow_convertible_v<_Tp, U>;
+        eop::is_nothrow_convertible_v<U, _Tp>;
 
     template< class _Tp, class U >
     inline
@@ -77,7 +94,7 @@ namespace eop
     bool linear_unusable_as_v =
         !(std::is_constructible_v<_Tp, U> ||
         std::is_assignable_v<_Tp&, U> ||
-        std::is_convertible_v<_Tp, U>);
+        std::is_convertible_v<U, _Tp>);
     
     /**
      * @brief Concept for linear/substructural types
@@ -96,7 +113,6 @@ namespace eop
      * std::unique_ptr<T> leads to undefined run-time behavior.
      * 
      */
-    #define linear typename
     template< class _Tp >
     inline
     constexpr
@@ -108,9 +124,16 @@ namespace eop
         && eop::linear_unusable_as_v<_Tp, const _Tp&>
         && eop::linear_unusable_as_v<_Tp, const _Tp>;
 
+    template< class _Tp >
+    concept linear = eop::is_linear_v<_Tp>;
+
     /**
      * @brief Wrapper object around a linear type
      * 
+     * The value is reached through $\func{operator*}$ and
+     * $\func{operator->}$ while the wrapper is held, and moved
+     * out by $\func{get}$ on an rvalue wrapper, which consumes it.
+     * 
      * @tparam T A linear Type
      */
     template< linear T >
@@ -120,7 +143,7 @@ namespace eop
         T _val;
 
     public:
-        linear_wrapper(T&& value) : _val(std::move(value)) {}
+        linear_wrapper(T&& value) noexcept : _val(std::move(value)) {}
 
         linear_wrapper(const linear_wrapper&) = delete;
         linear_wrapper &operator=(const linear_wrapper&) = delete;
@@ -129,15 +152,35 @@ namespace eop
         linear_wrapper &operator=(linear_wrapper&&) = default;
 
         [[nodiscard]]
-        T&& get(T&& value) && noexcept
+        T&& get() && noexcept
         {
-            return std::move(value);
+            return std::move(_val);
+        }
+
+        T& operator*() & noexcept
+        {
+            return _val;
+        }
+
+        const T& operator*() const& noexcept
+        {
+            return _val;
         }
 
         [[nodiscard]]
-        T&& operator*(T&& value) noexcept
+        T&& operator*() && noexcept
+        {
+            return std::move(_val);
+        }
+
+        T* operator->() noexcept
         {
-            return std::move(value);
+            return std::addressof(_val);
+        }
+
+        const T* operator->() const noexcept
+        {
+            return std::addressof(_val);
         }
     };
 
@@ -149,7 +192,6 @@ namespace eop
      * move_constructible && move_assignable
      * 
      */
-    #define semiregular typename
     template< class _Tp >
     inline
     constexpr
@@ -162,12 +204,14 @@ namespace eop
         && std::is_move_assignable_v<_Tp>
         && std::is_swappable_v<_Tp>;
 
+    template< class _Tp >
+    concept semiregular = eop::is_semiregular_v<_Tp>;
+
     /**
      * @brief Concept for types with an
      * equality comparability semantic
      * 
      */
-    #define equality_comparable typename
     template< class _Tp, class=void >
     struct is_equality_comparable : std::false_type{};
     template< class _Tp>
@@ -184,13 +228,63 @@ namespace eop
     bool is_equality_comparable_v =
         eop::is_equality_comparable<_Tp>::value;
 
+    template< class _Tp >
+    concept equality_comparable = eop::is_equality_comparable_v<_Tp>;
+
+    /**
+     * @brief Trait for types whose equality is equality of
+     * their object representations, so that ranges of them may
+     * be compared with memcmp
+     * 
+     * Holds for integral, enumeration and pointer types; other
+     * types may opt in by specialization when they have unique
+     * object representations and a memberwise equality.
+     * Floating-point types never qualify ($-0 = +0$, NaN).
+     * 
+     */
+    template< class _Tp >
+    struct is_trivially_equality_comparable
+        : std::bool_constant<std::is_integral_v<_Tp>
+                             || std::is_enum_v<_Tp>
+                             || std::is_pointer_v<_Tp>> {};
+
+    template< class _Tp >
+    inline
+    constexpr
+    bool is_trivially_equality_comparable_v =
+        eop::is_trivially_equality_comparable<std::remove_cv_t<_Tp>>::value
+        && std::has_unique_object_representations_v<std::remove_cv_t<_Tp>>;
+
+    /**
+     * @brief Trait for types whose objects may be relocated, i.e.
+     * moved to new storage ending the lifetime of the source
+     * without running its destructor, by copying their bytes
+     * 
+     * Holds for trivially copyable types. Other types may opt in
+     * by specialization when no part of an object refers to its
+     * own address, as for std::unique_ptr with the default
+     * deleter; libstdc++'s std::string, which points into itself,
+     * does not qualify.
+     * 
+     */
+    template< class _Tp >
+    struct is_trivially_relocatable : std::is_trivially_copyable<_Tp> {};
+
+    template< class _Tp >
+    struct is_trivially_relocatable<std::unique_ptr<_Tp>> : std::true_type {};
+
+    template< class _Tp >
+    inline
+    constexpr
+    bool is_trivially_relocatable_v =
+        eop::is_trivially_relocatable<std::remove_cv_t<_Tp>>::value;
+
     /**
      * @brief Concept for regular types
      * 
      * regular = semiregular && equality
      * 
      */
-    #define regular typename
     template< class _Tp >
     inline
     constexpr
@@ -198,12 +292,23 @@ namespace eop
         eop::is_semiregular_v<_Tp>
         && eop::is_equality_comparable_v<_Tp>;
 
+    template< class _Tp >
+    concept regular = eop::is_regular_v<_Tp>;
+
     /**
      * @brief Concepts for functional procedures and 
      * their input and output objects
      * 
+     * A functional procedure is an object type, called through
+     * an lvalue; its input and output types are given by
+     * specializing $\func{input}$ and $\func{output}$. Integral types
+     * standing for a domain qualify, so that the traits below may
+     * be keyed on them.
+     * 
      */
-    #define functional_procedure typename
+    template< class F >
+    concept functional_procedure = std::is_object_v<F>;
+
     template< functional_procedure F, const unsigned I >
     struct input {};
 
@@ -221,57 +326,256 @@ namespace eop
      * n_ary_operation = functional_procedure
      * && codomain(functional_procedure) =
      * 
+     * The domain is an optional argument, e.g.
+     * $unary\_predicate<eop::domain<F>> P$; without it only the
+     * functional procedure requirement is checked.
+     * 
      */
-    #define nullary_operation typename
-    #define nullary_predicate typename
-    #define unary_operation typename
-    #define unary_predicate typename
-    #define binary_operation typename
-    #define binary_predicate typename
-    #define n_ary_operation typename
-    #define n_ary_predicate typename
+    template< class Op >
+    concept nullary_operation = eop::functional_procedure<Op>
+        && std::invocable<Op&>;
+
+    template< class P >
+    concept nullary_predicate = eop::functional_procedure<P>
+        && std::predicate<P&>;
+
+    template< class Op, class... D >
+    concept unary_operation = eop::functional_procedure<Op>
+        && (sizeof...(D) <= 1)
+        && (... && std::convertible_to<std::invoke_result_t<Op&, D>, D>);
+
+    template< class P, class... D >
+    concept unary_predicate = eop::functional_procedure<P>
+        && (sizeof...(D) <= 1)
+        && (... && std::predicate<P&, D>);
+
+    template< class Op, class... D >
+    concept binary_operation = eop::functional_procedure<Op>
+        && (sizeof...(D) <= 1)
+        && (... && std::convertible_to<std::invoke_result_t<Op&, D, D>, D>);
+
+    template< class P, class... D >
+    concept binary_predicate = eop::functional_procedure<P>
+        && (sizeof...(D) <= 1)
+        && (... && std::predicate<P&, D, D>);
+
+    template< class Op, class... Args >
+    concept n_ary_operation = eop::functional_procedure<Op>
+        && (sizeof...(Args) == 0 || std::invocable<Op&, Args...>);
+
+    template< class P, class... Args >
+    concept n_ary_predicate = eop::functional_procedure<P>
+        && (sizeof...(Args) == 0 || std::predicate<P&, Args...>);
 
     /**
      * @brief Concept for transformations
      * 
-     * transformation = n_ary_operation
-     * || n_ary_predicate
+     * transformation = unary_operation
+     * && codomain(F) = domain(F)
+     * 
+     */
+    template< class F >
+    concept transformation = eop::functional_procedure<F>
+        && requires { typename eop::input<F, 0>::type; }
+        && eop::unary_operation<F, typename eop::input<F, 0>::type>;
+
+    /**
+     * @brief Unsigned counterpart of an integral type, including
+     * the 128-bit integers where the compiler provides them
      * 
+     * @tparam _Tp An integral type
      */
-    #define transformation typename
-    template< transformation F >
-    struct distance {};
+    template< class _Tp >
+    struct unsigned_counterpart : std::make_unsigned<_Tp> {};
+    #if defined(__SIZEOF_INT128__)
     template<>
-    struct distance<int>
-    {
-        using type = unsigned int;
-    };
+    struct unsigned_counterpart<__int128> { using type = unsigned __int128; };
     template<>
-    struct distance<long long>
+    struct unsigned_counterpart<unsigned __int128> { using type = unsigned __int128; };
+    #endif
+
+    template< class _Tp >
+    inline
+    constexpr
+    bool is_wide_integral_v = std::is_integral_v<_Tp>
+    #if defined(__SIZEOF_INT128__)
+        || std::is_same_v<std::remove_cv_t<_Tp>, __int128>
+        || std::is_same_v<std::remove_cv_t<_Tp>, unsigned __int128>
+    #endif
+        ;
+
+    template< class _Tp, class=void >
+    struct has_distance_type_member : std::false_type{};
+    template< class _Tp >
+    struct has_distance_type_member<_Tp,
+        typename std::enable_if<
+            true,
+            decltype(std::declval<typename _Tp::distance_type*>(),
+                (void)0)>::type
+            > : std::true_type {};
+
+    template< class F, class=void >
+    struct has_domain : std::false_type{};
+    template< class F >
+    struct has_domain<F,
+        typename std::enable_if<
+            true,
+            decltype(std::declval<typename input<F, 0>::type*>(),
+                (void)0)>::type
+            > : std::true_type {};
+
+    /**
+     * @brief Derivation of the distance type of a transformation
+     * that does not specialize $\func{distance}$
+     * 
+     * In order: a nested $\func{distance_type}$; the derivation
+     * for the domain of F, when $\func{input}$ names one; the
+     * unsigned counterpart of F itself when F is an integral or
+     * enumeration type standing for a domain, which can count
+     * every step of an orbit in it. Otherwise there is no
+     * $\func{type}$, and $\func{distance}$ must be specialized.
+     * 
+     * @tparam F A type for transformation
+     */
+    template< class F, class=void >
+    struct default_distance {};
+    template< class F >
+    struct default_distance<F,
+        std::enable_if_t<eop::has_distance_type_member<F>::value>>
     {
-        using type = unsigned long long;
+        using type = typename F::distance_type;
     };
+    template< class F >
+    struct default_distance<F,
+        std::enable_if_t<!eop::has_distance_type_member<F>::value
+                         && eop::has_domain<F>::value>>
+        : eop::default_distance<std::remove_cv_t<typename input<F, 0>::type>> {};
+    template< class F >
+    struct default_distance<F,
+        std::enable_if_t<!eop::has_distance_type_member<F>::value
+                         && !eop::has_domain<F>::value
+                         && eop::is_wide_integral_v<F>>>
+        : eop::unsigned_counterpart<F> {};
+    template< class F >
+    struct default_distance<F,
+        std::enable_if_t<!eop::has_distance_type_member<F>::value
+                         && !eop::has_domain<F>::value
+                         && std::is_enum_v<F>>>
+        : eop::unsigned_counterpart<std::underlying_type_t<F>> {};
+
+    template< functional_procedure F >
+    struct distance : eop::default_distance<F> {};
+
+    /**
+     * @brief Concept for transformations with a known
+     * composition law
+     * 
+     * composable_transformation = transformation
+     * && composition<F>::compose(f, g) = f . g
+     * && composition<F>::identity(f) = f^0
+     * 
+     * Specialize $\func{composition}$ with static $\func{compose}$
+     * and $\func{identity}$ members to opt a transformation type
+     * into doubling, e.g. for affine maps or permutation tables.
+     * 
+     */
+    template< functional_procedure F >
+    struct composition {};
+
+    template< class F, class=void >
+    struct is_composable_transformation : std::false_type{};
+    template< class F >
+    struct is_composable_transformation<F,
+        typename std::enable_if<
+            true,
+            decltype(eop::composition<F>::compose(std::declval<const F&>(),
+                                                  std::declval<const F&>()),
+                eop::composition<F>::identity(std::declval<const F&>()),
+                (void)0)>::type
+            > : std::true_type {};
+
+    template< class F >
+    inline
+    constexpr
+    bool is_composable_transformation_v =
+        eop::is_composable_transformation<F>::value;
+
+    template< class F >
+    concept composable_transformation = eop::transformation<F>
+        && eop::is_composable_transformation_v<F>;
+
+    /**
+     * @brief Trait for transformations whose application is a
+     * memory access, e.g. a lookup in a table larger than the
+     * cache
+     * 
+     * Specialize $\func{prefetch_hint}$ with a static
+     * $\func{prefetch}(f, x)$ that starts loading what $f(x)$ will
+     * read, so that interleaved walks overlap the misses of
+     * several orbits instead of stalling on each.
+     * 
+     */
+    template< functional_procedure F >
+    struct prefetch_hint {};
+
+    template< class F, class=void >
+    struct is_prefetchable_transformation : std::false_type{};
+    template< class F >
+    struct is_prefetchable_transformation<F,
+        typename std::enable_if<
+            true,
+            decltype(eop::prefetch_hint<F>::prefetch(std::declval<const F&>(),
+                std::declval<const typename eop::input<F, 0>::type&>()),
+                (void)0)>::type
+            > : std::true_type {};
+
+    template< class F >
+    inline
+    constexpr
+    bool is_prefetchable_transformation_v =
+        eop::is_prefetchable_transformation<F>::value;
 
     /**
      * @brief Concept for types on which
      * arithmetic can be performed
      * 
      */
-    #define arithmetic typename
+    template< class _Tp >
+    concept arithmetic = std::is_arithmetic_v<_Tp> || eop::is_wide_integral_v<_Tp>;
 
     /**
      * @brief Models for data structures,
      * iterators, and containers
      *
+     * A reverse iterator is a bidirectional iterator traversed
+     * backward; a linear structure is a container traversed in
+     * one direction and a coordinate structure is reached through
+     * coordinates, e.g. iterators.
+     *
      */
-    #define container typename
-    #define linear_structure typename
-    #define coordinate_structure typename
-    #define iterator typename
-    #define forward_iterator typename
-    #define reverse_iterator typename
-    #define bidirectional_iterator typename
-    #define random_access_iterator typename
+    template< class C >
+    concept container = std::ranges::range<C>;
+
+    template< class C >
+    concept linear_structure = std::ranges::forward_range<C>;
+
+    template< class C >
+    concept coordinate_structure = eop::regular<C>;
+
+    template< class I >
+    concept iterator = std::input_or_output_iterator<I>;
+
+    template< class I >
+    concept forward_iterator = std::forward_iterator<I>;
+
+    template< class I >
+    concept bidirectional_iterator = std::bidirectional_iterator<I>;
+
+    template< class I >
+    concept reverse_iterator = std::bidirectional_iterator<I>;
+
+    template< class I >
+    concept random_access_iterator = std::random_access_iterator<I>;
 
     /**
      * @brief Aliases for types
@@ -295,7 +599,7 @@ namespace eop
     template< functional_procedure F >
     using codomain = typename output<F>::type;
 
-    template< transformation F >
+    template< functional_procedure F >
     using distance_type = typename distance<F>::type;
 
     template< iterator I >
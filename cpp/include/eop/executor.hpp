@@ -0,0 +1,306 @@
+#ifndef EOP_EXECUTOR_HPP
+#define EOP_EXECUTOR_HPP
+
+#include "concepts.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Fixed-size pool of worker threads running
+     * chunked loops with range stealing
+     * 
+     * Each participant (the workers plus the calling thread)
+     * starts with a contiguous share of the chunk indices, held
+     * as a packed [lo, hi) pair in one atomic word. Owners take
+     * chunks from the front; an idle participant steals the back
+     * half of a victim's remaining range, so chunks that turn out
+     * to be expensive are spread over the idle threads without a
+     * central queue.
+     * 
+     * Loops submitted from several threads run one after the
+     * other, and a loop submitted from inside the body of a loop,
+     * of this pool or another, runs serially on the calling
+     * thread, so sharing one pool never deadlocks.
+     * 
+     */
+    class work_stealing_pool
+    {
+    private:
+        struct alignas(64) slot
+        {
+            std::atomic<std::uint64_t> range{0};
+        };
+
+        static constexpr std::uint64_t pack(std::uint64_t lo, std::uint64_t hi) noexcept
+        {
+            return (lo << 32) | hi;
+        }
+
+        std::vector<std::thread> _threads;
+        std::unique_ptr<slot[]> _slots;
+        std::size_t _participants;
+
+        /** Held by the thread whose loop is running */
+        std::mutex _submit;
+        std::mutex _mutex;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        std::size_t _generation = 0;
+        std::size_t _running = 0;
+        bool _stop = false;
+
+        std::function<void(std::size_t, std::size_t)> _body;
+        std::size_t _n = 0;
+        std::size_t _chunk = 1;
+        std::exception_ptr _error;
+        /** The cancel flag of the loop running on the workers */
+        std::atomic<bool> _cancelled{false};
+
+        /**
+         * The cancel flag of the innermost loop whose body this
+         * thread is running, or null outside any body
+         */
+        static inline thread_local std::atomic<bool>* _loop = nullptr;
+
+        struct body_scope
+        {
+            std::atomic<bool>* outer = _loop;
+
+            explicit body_scope(std::atomic<bool>& cancelled) noexcept { _loop = &cancelled; }
+            ~body_scope() { _loop = outer; }
+        };
+
+        template< class Fn >
+        static void run_serially(std::size_t n, std::size_t chunk, Fn& body)
+        {
+            std::atomic<bool> cancelled{false};
+            body_scope scope(cancelled);
+            for (std::size_t b = 0; b < n; b += chunk)
+            {
+                if (cancelled.load(std::memory_order_relaxed)) return;
+                body(b, b + chunk < n ? b + chunk : n);
+            }
+        }
+
+        bool pop(std::size_t id, std::uint64_t& c) noexcept
+        {
+            std::uint64_t r = _slots[id].range.load(std::memory_order_acquire);
+            while (true)
+            {
+                std::uint64_t lo = r >> 32, hi = r & 0xFFFFFFFFu;
+                if (lo >= hi) return false;
+                if (_slots[id].range.compare_exchange_weak(r, pack(lo + 1, hi),
+                    std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    c = lo;
+                    return true;
+                }
+            }
+        }
+
+        bool steal(std::size_t id) noexcept
+        {
+            for (std::size_t k = 1; k < _participants; ++k)
+            {
+                std::size_t v = (id + k) % _participants;
+                std::uint64_t r = _slots[v].range.load(std::memory_order_acquire);
+                while (true)
+                {
+                    std::uint64_t lo = r >> 32, hi = r & 0xFFFFFFFFu;
+                    if (lo >= hi) break;
+                    std::uint64_t half = (hi - lo + 1) / 2;
+                    if (_slots[v].range.compare_exchange_weak(r, pack(lo, hi - half),
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        _slots[id].range.store(pack(hi - half, hi),
+                            std::memory_order_release);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void participate(std::size_t id) noexcept
+        {
+            body_scope scope(_cancelled);
+            std::uint64_t c;
+            do
+            {
+                while (!_cancelled.load(std::memory_order_relaxed) && pop(id, c))
+                {
+                    std::size_t b = std::size_t(c) * _chunk;
+                    std::size_t e = b + _chunk < _n ? b + _chunk : _n;
+                    try
+                    {
+                        _body(b, e);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (!_error) _error = std::current_exception();
+                    }
+                }
+            } while (!_cancelled.load(std::memory_order_relaxed) && steal(id));
+        }
+
+        void work(std::size_t id) noexcept
+        {
+            std::size_t seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _start.wait(lock, [&] { return _stop || _generation != seen; });
+                    if (_stop) return;
+                    seen = _generation;
+                }
+                participate(id);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (--_running == 0) _done.notify_one();
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Starts the pool
+         * 
+         * @param threads The number of participants including the
+         * calling thread; zero means one per hardware thread
+         */
+        explicit work_stealing_pool(std::size_t threads = 0)
+        {
+            if (threads == 0) threads = std::thread::hardware_concurrency();
+            if (threads == 0) threads = 1;
+            _participants = threads;
+            _slots.reset(new slot[threads]);
+            _threads.reserve(threads - 1);
+            for (std::size_t id = 0; id + 1 < threads; ++id)
+                _threads.emplace_back([this, id] { work(id); });
+        }
+
+        work_stealing_pool(const work_stealing_pool&) = delete;
+        work_stealing_pool &operator=(const work_stealing_pool&) = delete;
+
+        ~work_stealing_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _start.notify_all();
+            for (auto& t : _threads) t.join();
+        }
+
+        /**
+         * @brief The number of participants, including the
+         * calling thread
+         * 
+         * @return std::size_t 
+         */
+        std::size_t size() const noexcept
+        {
+            return _participants;
+        }
+
+        /**
+         * @brief Runs body(b, e) over consecutive chunks [b, e)
+         * covering [0, n), and returns once every chunk has run
+         * 
+         * Chunks run concurrently and in no particular order, so
+         * body must only write state owned by its own chunk. The
+         * first exception thrown by body is rethrown here; body may
+         * call $\func{cancel}$ to skip the chunks of this loop not
+         * yet started.
+         * 
+         * Concurrent calls are serialized. A call from inside body,
+         * to this pool or another, runs its chunks serially on the
+         * calling thread.
+         * 
+         * @tparam Fn A type for an operation on index ranges
+         * @param n The index count
+         * @param chunk The chunk size hint; zero picks one giving
+         * each participant several chunks to balance with
+         * @param body The operation
+         */
+        template< class Fn >
+        void parallel_for(std::size_t n, std::size_t chunk, Fn body)
+        {
+            if (n == 0) return;
+            if (chunk == 0) chunk = n / (_participants * 16);
+            if (chunk == 0) chunk = 1;
+            std::size_t chunks = (n + chunk - 1) / chunk;
+            if (chunks > 0xFFFFFFFFu)
+            {
+                chunk = (n + 0xFFFFFFFEu) / 0xFFFFFFFFu;
+                chunks = (n + chunk - 1) / chunk;
+            }
+            // Nested: the workers may all be blocked in the enclosing
+            // loop, so wait on nobody
+            if (_loop) return run_serially(n, chunk, body);
+            std::lock_guard<std::mutex> submit(_submit);
+            _cancelled.store(false, std::memory_order_relaxed);
+            if (_participants == 1 || chunks == 1) return run_serially(n, chunk, body);
+            for (std::size_t id = 0; id < _participants; ++id)
+            {
+                std::uint64_t lo = chunks * id / _participants;
+                std::uint64_t hi = chunks * (id + 1) / _participants;
+                _slots[id].range.store(pack(lo, hi), std::memory_order_relaxed);
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _body = std::ref(body);
+                _n = n;
+                _chunk = chunk;
+                _error = nullptr;
+                _running = _participants - 1;
+                ++_generation;
+            }
+            _start.notify_all();
+            participate(_participants - 1);
+            std::exception_ptr error;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done.wait(lock, [&] { return _running == 0; });
+                _body = nullptr;
+                error = _error;
+            }
+            if (error) std::rethrow_exception(error);
+        }
+
+        /**
+         * @brief Stops the innermost loop whose body the calling
+         * thread is running from starting further chunks; chunks
+         * already running complete normally
+         * 
+         * Each loop has its own flag, so cancelling a loop nested
+         * in a body leaves the enclosing loop running. Outside any
+         * body, cancel does nothing.
+         * 
+         */
+        void cancel() noexcept
+        {
+            if (_loop) _loop->store(true, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief A process-wide pool with one participant per
+     * hardware thread, started on first use
+     * 
+     * Callers on different threads take turns, and calls nested
+     * in a loop body run serially.
+     * 
+     * @return eop::work_stealing_pool& 
+     */
+    inline
+    eop::work_stealing_pool& default_pool()
+    {
+        static eop::work_stealing_pool pool;
+        return pool;
+    }
+} // namespace eop
+
+#endif // !EOP_EXECUTOR_HPP
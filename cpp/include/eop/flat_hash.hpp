@@ -0,0 +1,1078 @@
+#ifndef EOP_FLAT_HASH_HPP
+#define EOP_FLAT_HASH_HPP
+
+#include "intrinsics.hpp"
+#include "simd.hpp"
+
+namespace eop
+{
+    /**
+     * @brief Folded multiply: the high and low halves of the
+     * 128-bit product $a \cdot b$, xored together
+     *
+     * Every bit of either factor affects most bits of the
+     * result, which makes it a one-instruction mixer.
+     *
+     * @param a A word
+     * @param b A word
+     * @return std::uint64_t
+     */
+    inline
+    constexpr
+    std::uint64_t hash_fold(std::uint64_t a, std::uint64_t b) noexcept
+    {
+    #if defined(__SIZEOF_INT128__)
+        unsigned __int128 m = static_cast<unsigned __int128>(a) * b;
+        return std::uint64_t(m) ^ std::uint64_t(m >> 64);
+    #else
+        std::uint64_t x = a ^ std::rotl(b, 32);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    #endif
+    }
+
+    /**
+     * @brief Spreads a word of hash over all 64 bits
+     *
+     * The low bits of the result select the control byte and the
+     * high bits the group in eop::flat_table, so identity hashes
+     * such as those of std::hash for integers are mixed first.
+     *
+     * @param x A word
+     * @return std::uint64_t
+     */
+    inline
+    constexpr
+    std::uint64_t hash_mix(std::uint64_t x) noexcept
+    {
+        return eop::hash_fold(x ^ 0x243F6A8885A308D3ull, 0x9E3779B97F4A7C15ull);
+    }
+
+    /**
+     * @brief Hashes n bytes, eight at a time
+     *
+     * @param p The bytes
+     * @param n The number of bytes
+     * @return std::uint64_t
+     */
+    inline
+    std::uint64_t hash_bytes(const void* p, std::size_t n) noexcept
+    {
+        const unsigned char* s = static_cast<const unsigned char*>(p);
+        std::uint64_t h = eop::hash_mix(std::uint64_t(n));
+        for (; n >= 8; s += 8, n -= 8)
+        {
+            std::uint64_t w;
+            std::memcpy(&w, s, 8);
+            h = eop::hash_fold(h ^ 0xA0761D6478BD642Full, w ^ 0xE7037ED1A0B428DBull);
+        }
+        if (n != 0)
+        {
+            std::uint64_t w = 0;
+            std::memcpy(&w, s, n);
+            h = eop::hash_fold(h ^ 0xA0761D6478BD642Full, w ^ 0xE7037ED1A0B428DBull);
+        }
+        return h;
+    }
+
+    /**
+     * @brief Hash function object for regular types, and
+     * customization point of the flat hash containers
+     *
+     * In order of preference, a value is hashed by
+     * - $\func{hash_value}(x)$, found by argument-dependent lookup,
+     *   which is how user types opt in;
+     * - its value, for integral, enumeration, pointer and
+     *   floating-point types ($-0$ and $+0$ hash alike);
+     * - its object representation, for other types satisfying
+     *   eop::is_trivially_equality_comparable_v;
+     * - std::hash, when enabled for the type.
+     *
+     * Results are mixed so that both the low and the high bits
+     * are usable. Types may also specialize eop::hash directly;
+     * a specialization defining is_transparent, as those for
+     * strings do, enables heterogeneous lookup.
+     *
+     * @tparam _Tp A regular type
+     */
+    template< class _Tp >
+    struct hash
+    {
+        std::size_t operator()(const _Tp& x) const noexcept
+        {
+            if constexpr (requires { { hash_value(x) } -> std::convertible_to<std::uint64_t>; })
+                return std::size_t(eop::hash_mix(std::uint64_t(hash_value(x))));
+            else if constexpr (std::is_enum_v<_Tp>)
+                return eop::hash<std::underlying_type_t<_Tp>>()(
+                    static_cast<std::underlying_type_t<_Tp>>(x));
+            else if constexpr (std::is_integral_v<_Tp> && sizeof(_Tp) <= 8)
+                return std::size_t(eop::hash_mix(std::uint64_t(
+                    static_cast<std::make_unsigned_t<_Tp>>(x))));
+            else if constexpr (std::is_pointer_v<_Tp>)
+                return std::size_t(eop::hash_mix(std::uint64_t(std::uintptr_t(x))));
+            else if constexpr (std::is_same_v<_Tp, float>)
+                return std::size_t(eop::hash_mix(x == 0.0f ? 0 : std::bit_cast<std::uint32_t>(x)));
+            else if constexpr (std::is_same_v<_Tp, double>)
+                return std::size_t(eop::hash_mix(x == 0.0 ? 0 : std::bit_cast<std::uint64_t>(x)));
+            else if constexpr (eop::is_trivially_equality_comparable_v<_Tp>)
+                return std::size_t(eop::hash_bytes(std::addressof(x), sizeof(_Tp)));
+            else if constexpr (requires { std::hash<_Tp>()(x); })
+                return std::size_t(eop::hash_mix(std::uint64_t(std::hash<_Tp>()(x))));
+            else
+                static_assert(!sizeof(_Tp), "no hash for this type: define hash_value "
+                    "or specialize eop::hash");
+        }
+    };
+
+    template< class C, class Tr >
+    struct hash<std::basic_string_view<C, Tr>>
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::basic_string_view<C, Tr> s) const noexcept
+        {
+            return std::size_t(eop::hash_bytes(s.data(), s.size() * sizeof(C)));
+        }
+    };
+
+    template< class C, class Tr, class A >
+    struct hash<std::basic_string<C, Tr, A>> : eop::hash<std::basic_string_view<C, Tr>> {};
+
+    template< class _Tp, class U >
+    struct hash<std::pair<_Tp, U>>
+    {
+        std::size_t operator()(const std::pair<_Tp, U>& p) const noexcept
+        {
+            return std::size_t(eop::hash_fold(
+                std::uint64_t(eop::hash<_Tp>()(p.first)) ^ 0xA0761D6478BD642Full,
+                std::uint64_t(eop::hash<U>()(p.second)) ^ 0xE7037ED1A0B428DBull));
+        }
+    };
+
+    /**
+     * @brief Control bytes of a flat hash table: a full slot
+     * holds the low seven bits of its hash, other slots one of
+     * the negative markers below
+     *
+     */
+    inline
+    constexpr
+    std::int8_t flat_empty = -128;
+
+    inline
+    constexpr
+    std::int8_t flat_deleted = -2;
+
+    inline
+    constexpr
+    std::int8_t flat_sentinel = -1;
+
+    /**
+     * @brief A group of consecutive control bytes, matched all at
+     * once: 16 with one SSE2 comparison, or 8 in a 64-bit word
+     *
+     * A match is a bit mask with one bit per matching byte; the
+     * portable matcher of a hash may report false positives, but
+     * never for the empty and deleted markers.
+     *
+     */
+    struct flat_group
+    {
+    #if defined(EOP_SIMD_X86)
+        static constexpr std::size_t width = 16;
+        static constexpr unsigned shift = 0;
+        using mask_type = std::uint32_t;
+
+        __m128i ctrl;
+
+        explicit flat_group(const std::int8_t* p) noexcept
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        mask_type match(std::int8_t h) const noexcept
+        {
+            return mask_type(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h))));
+        }
+
+        mask_type match_empty() const noexcept
+        {
+            return match(eop::flat_empty);
+        }
+
+        mask_type match_empty_or_deleted() const noexcept
+        {
+            return mask_type(_mm_movemask_epi8(
+                _mm_cmpgt_epi8(_mm_set1_epi8(eop::flat_sentinel), ctrl)));
+        }
+    #else
+        static constexpr std::size_t width = 8;
+        static constexpr unsigned shift = 3;
+        using mask_type = std::uint64_t;
+
+        static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+        static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+
+        std::uint64_t ctrl = 0;
+
+        explicit flat_group(const std::int8_t* p) noexcept
+        {
+            for (std::size_t i = 0; i < width; ++i)
+                ctrl |= std::uint64_t(std::uint8_t(p[i])) << (8 * i);
+        }
+
+        mask_type match(std::int8_t h) const noexcept
+        {
+            std::uint64_t x = ctrl ^ (lsbs * std::uint8_t(h));
+            return (x - lsbs) & ~x & msbs;
+        }
+
+        mask_type match_empty() const noexcept
+        {
+            return ctrl & ~(ctrl << 6) & msbs;
+        }
+
+        mask_type match_empty_or_deleted() const noexcept
+        {
+            return ctrl & ~(ctrl << 7) & msbs;
+        }
+    #endif
+
+        static std::size_t lowest(mask_type m) noexcept
+        {
+            return std::size_t(std::countr_zero(m)) >> shift;
+        }
+
+        static std::size_t leading(mask_type m) noexcept
+        {
+            return std::size_t(std::countl_zero(m)
+                - int(8 * sizeof(mask_type) - (width << shift))) >> shift;
+        }
+    };
+
+    /**
+     * @brief Control bytes of a table with no slots: a sentinel,
+     * so that iteration ends at once, followed by empty bytes, so
+     * that lookups stop at the first group
+     *
+     */
+    alignas(16) inline constexpr std::int8_t flat_empty_group[16] = {
+        eop::flat_sentinel, eop::flat_empty, eop::flat_empty, eop::flat_empty,
+        eop::flat_empty, eop::flat_empty, eop::flat_empty, eop::flat_empty,
+        eop::flat_empty, eop::flat_empty, eop::flat_empty, eop::flat_empty,
+        eop::flat_empty, eop::flat_empty, eop::flat_empty, eop::flat_empty };
+
+    template< class H, class Eq >
+    concept transparent_lookup = requires
+    {
+        typename H::is_transparent;
+        typename Eq::is_transparent;
+    };
+
+    /**
+     * @brief Open-addressing hash table in the layout of
+     * SwissTable, shared by eop::flat_set and eop::flat_map
+     *
+     * One allocation holds a control byte per slot, followed by
+     * the slots themselves. The hash of a key is split into H1,
+     * which chooses the group where probing starts, and H2, its
+     * low seven bits, stored in the control byte. A lookup
+     * compares H2 against a whole group of control bytes at once
+     * and only compares keys on a match, so misses rarely touch
+     * the slots; groups are probed triangularly until one
+     * contains an empty byte.
+     *
+     * The capacity is one less than a power of two, and the
+     * table grows at a load of 7/8. The first group is mirrored
+     * after a sentinel byte, so that a group can be loaded from
+     * any slot. Erasure leaves a tombstone only if a probe could
+     * have run past the slot, and tombstones are dropped by
+     * rehashing in place of growth when they dominate.
+     *
+     * Insertion invalidates iterators when the table rehashes;
+     * erasure invalidates only those to the erased element.
+     *
+     * Precondition: hashing, comparing and moving elements do
+     * not throw
+     *
+     * @tparam Policy The element layout: key, slot and value types
+     * @tparam H A hash function type for the key type
+     * @tparam Eq An equality type for the key type
+     */
+    template< class Policy, class H, class Eq >
+    class flat_table
+    {
+    public:
+        using key_type = typename Policy::key_type;
+        using value_type = typename Policy::value_type;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using hasher = H;
+        using key_equal = Eq;
+
+    protected:
+        using slot_type = typename Policy::slot_type;
+        using group = eop::flat_group;
+
+        static constexpr size_type npos = ~size_type(0);
+        static constexpr size_type cloned = group::width - 1;
+
+        std::int8_t* _ctrl = const_cast<std::int8_t*>(eop::flat_empty_group);
+        slot_type* _slots = nullptr;
+        size_type _capacity = 0;
+        size_type _size = 0;
+        size_type _growth_left = 0;
+        [[no_unique_address]] H _hash;
+        [[no_unique_address]] Eq _eq;
+
+        template< bool Const >
+        class iterator_type
+        {
+        private:
+            using S = std::conditional_t<Const, const slot_type, slot_type>;
+
+            const std::int8_t* _c = nullptr;
+            S* _s = nullptr;
+
+            friend class flat_table;
+            friend class iterator_type<!Const>;
+
+            iterator_type(const std::int8_t* c, S* s) noexcept : _c(c), _s(s) {}
+
+            void skip() noexcept
+            {
+                while (*_c < eop::flat_sentinel)
+                {
+                    ++_c;
+                    ++_s;
+                }
+            }
+
+        public:
+            using value_type = typename Policy::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = decltype(Policy::element(std::declval<S&>()));
+            using pointer = std::remove_reference_t<reference>*;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator_type() = default;
+
+            operator iterator_type<true>() const noexcept requires (!Const)
+            {
+                return iterator_type<true>(_c, _s);
+            }
+
+            reference operator*() const noexcept
+            {
+                return Policy::element(*_s);
+            }
+
+            pointer operator->() const noexcept
+            {
+                return std::addressof(**this);
+            }
+
+            iterator_type& operator++() noexcept
+            {
+                ++_c;
+                ++_s;
+                skip();
+                return *this;
+            }
+
+            iterator_type operator++(int) noexcept
+            {
+                iterator_type i = *this;
+                ++*this;
+                return i;
+            }
+
+            friend bool operator==(const iterator_type& i, const iterator_type& j) noexcept
+            {
+                return i._c == j._c;
+            }
+        };
+
+    public:
+        using iterator = iterator_type<false>;
+        using const_iterator = iterator_type<true>;
+
+    protected:
+        static size_type normalize_capacity(size_type n) noexcept
+        {
+            return n == 0 ? 1 : ~size_type(0) >> std::countl_zero(n);
+        }
+
+        static size_type capacity_to_growth(size_type c) noexcept
+        {
+            return group::width == 8 && c == 7 ? 6 : c - c / 8;
+        }
+
+        static size_type growth_to_capacity(size_type g) noexcept
+        {
+            return group::width == 8 && g == 7 ? 8 : g + (g - 1) / 7;
+        }
+
+        static size_type slots_offset(size_type c) noexcept
+        {
+            constexpr size_type a = alignof(slot_type);
+            return (c + group::width + a - 1) & ~(a - 1);
+        }
+
+        static constexpr bool overaligned =
+            alignof(slot_type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        static bool is_full(std::int8_t c) noexcept
+        {
+            return c >= 0;
+        }
+
+        std::uint64_t hash_of(const auto& k) const noexcept
+        {
+            return std::uint64_t(_hash(k));
+        }
+
+        void set_ctrl(size_type i, std::int8_t h) noexcept
+        {
+            _ctrl[i] = h;
+            _ctrl[((i - cloned) & _capacity) + (cloned & _capacity)] = h;
+        }
+
+        size_type find_first_non_full(std::uint64_t h) const noexcept
+        {
+            size_type offset = size_type(h >> 7) & _capacity;
+            for (size_type step = group::width; ; step += group::width)
+            {
+                typename group::mask_type m = group(_ctrl + offset).match_empty_or_deleted();
+                if (m) return (offset + group::lowest(m)) & _capacity;
+                offset = (offset + step) & _capacity;
+            }
+        }
+
+        template< class Q >
+        size_type find_index(const Q& k, std::uint64_t h) const noexcept
+        {
+            std::int8_t h2 = std::int8_t(h & 0x7F);
+            size_type offset = size_type(h >> 7) & _capacity;
+            for (size_type step = group::width; ; step += group::width)
+            {
+                group g(_ctrl + offset);
+                for (typename group::mask_type m = g.match(h2); m; m &= m - 1)
+                {
+                    size_type i = (offset + group::lowest(m)) & _capacity;
+                    if (_eq(Policy::key(_slots[i]), k)) return i;
+                }
+                if (g.match_empty()) return npos;
+                offset = (offset + step) & _capacity;
+            }
+        }
+
+        void allocate(size_type c)
+        {
+            size_type bytes = slots_offset(c) + c * sizeof(slot_type);
+            std::byte* p = static_cast<std::byte*>(overaligned
+                ? ::operator new(bytes, std::align_val_t(alignof(slot_type)))
+                : ::operator new(bytes));
+            _ctrl = reinterpret_cast<std::int8_t*>(p);
+            _slots = reinterpret_cast<slot_type*>(p + slots_offset(c));
+            _capacity = c;
+            reset_ctrl();
+        }
+
+        void reset_ctrl() noexcept
+        {
+            std::memset(_ctrl, std::uint8_t(eop::flat_empty), _capacity + group::width);
+            _ctrl[_capacity] = eop::flat_sentinel;
+            _growth_left = capacity_to_growth(_capacity) - _size;
+        }
+
+        static void deallocate(std::int8_t* ctrl) noexcept
+        {
+            if constexpr (overaligned)
+                ::operator delete(ctrl, std::align_val_t(alignof(slot_type)));
+            else
+                ::operator delete(ctrl);
+        }
+
+        void deallocate() noexcept
+        {
+            if (_capacity == 0) return;
+            deallocate(_ctrl);
+            _ctrl = const_cast<std::int8_t*>(eop::flat_empty_group);
+            _slots = nullptr;
+            _capacity = 0;
+        }
+
+        void destroy_all() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<slot_type>)
+                for (size_type i = 0; i < _capacity; ++i)
+                    if (is_full(_ctrl[i])) std::destroy_at(_slots + i);
+        }
+
+        /**
+         * @brief Moves every element into a fresh allocation of
+         * capacity c, dropping tombstones
+         *
+         * @param c The new capacity, one less than a power of two
+         */
+        void resize(size_type c)
+        {
+            std::int8_t* ctrl = _ctrl;
+            slot_type* slots = _slots;
+            size_type capacity = _capacity;
+            allocate(c);
+            for (size_type i = 0; i < capacity; ++i)
+            {
+                if (!is_full(ctrl[i])) continue;
+                std::uint64_t h = hash_of(Policy::key(slots[i]));
+                size_type j = find_first_non_full(h);
+                set_ctrl(j, std::int8_t(h & 0x7F));
+                eop::relocate_at(slots + i, _slots + j);
+            }
+            _growth_left = capacity_to_growth(_capacity) - _size;
+            if (capacity != 0) deallocate(ctrl);
+        }
+
+        void rehash_and_grow()
+        {
+            if (_capacity > group::width && _size * 32 <= _capacity * 25)
+                resize(_capacity);
+            else
+                resize(_capacity * 2 + 1);
+        }
+
+        /**
+         * @brief The slot where an element of hash h is to be
+         * constructed, growing the table if need be; the insertion
+         * is committed by eop::flat_table::commit
+         *
+         */
+        size_type prepare_insert(std::uint64_t h)
+        {
+            size_type i = find_first_non_full(h);
+            if (_growth_left == 0 && _ctrl[i] != eop::flat_deleted)
+            {
+                rehash_and_grow();
+                i = find_first_non_full(h);
+            }
+            return i;
+        }
+
+        void commit(size_type i, std::uint64_t h) noexcept
+        {
+            _growth_left -= size_type(_ctrl[i] == eop::flat_empty);
+            set_ctrl(i, std::int8_t(h & 0x7F));
+            ++_size;
+        }
+
+        template< class Q, class... Args >
+        std::pair<iterator, bool> find_or_emplace(const Q& k, Args&&... args)
+        {
+            std::uint64_t h = hash_of(k);
+            size_type i = find_index(k, h);
+            if (i != npos) return { iterator_at(i), false };
+            i = prepare_insert(h);
+            std::construct_at(_slots + i, std::forward<Args>(args)...);
+            commit(i, h);
+            return { iterator_at(i), true };
+        }
+
+        void erase_at(size_type i) noexcept
+        {
+            std::destroy_at(_slots + i);
+            --_size;
+            typename group::mask_type after = group(_ctrl + i).match_empty();
+            typename group::mask_type before =
+                group(_ctrl + ((i - group::width) & _capacity)).match_empty();
+            bool never_full = _capacity < group::width || (before && after
+                && group::lowest(after) + group::leading(before) < group::width);
+            set_ctrl(i, never_full ? eop::flat_empty : eop::flat_deleted);
+            _growth_left += size_type(never_full);
+        }
+
+        iterator iterator_at(size_type i) noexcept
+        {
+            return iterator(_ctrl + i, _slots + i);
+        }
+
+        const_iterator iterator_at(size_type i) const noexcept
+        {
+            return const_iterator(_ctrl + i, _slots + i);
+        }
+
+        void copy_from(const flat_table& t)
+        {
+            reserve(t._size);
+            for (size_type i = 0; i < t._capacity; ++i)
+            {
+                if (!is_full(t._ctrl[i])) continue;
+                std::uint64_t h = hash_of(Policy::key(t._slots[i]));
+                size_type j = find_first_non_full(h);
+                std::construct_at(_slots + j, t._slots[i]);
+                commit(j, h);
+            }
+        }
+
+    public:
+        flat_table() = default;
+
+        /**
+         * @brief Creates an empty table with room for n elements
+         *
+         * @param n The number of elements to reserve room for
+         * @param hash The hash function
+         * @param eq The key equality
+         */
+        explicit flat_table(size_type n, const H& hash = H(), const Eq& eq = Eq())
+            : _hash(hash), _eq(eq)
+        {
+            reserve(n);
+        }
+
+        flat_table(const flat_table& t) : _hash(t._hash), _eq(t._eq)
+        {
+            copy_from(t);
+        }
+
+        flat_table(flat_table&& t) noexcept
+            : _ctrl(std::exchange(t._ctrl, const_cast<std::int8_t*>(eop::flat_empty_group))),
+              _slots(std::exchange(t._slots, nullptr)),
+              _capacity(std::exchange(t._capacity, 0)),
+              _size(std::exchange(t._size, 0)),
+              _growth_left(std::exchange(t._growth_left, 0)),
+              _hash(t._hash), _eq(t._eq) {}
+
+        flat_table& operator=(flat_table t) noexcept
+        {
+            swap(t);
+            return *this;
+        }
+
+        ~flat_table()
+        {
+            destroy_all();
+            deallocate();
+        }
+
+        void swap(flat_table& t) noexcept
+        {
+            std::swap(_ctrl, t._ctrl);
+            std::swap(_slots, t._slots);
+            std::swap(_capacity, t._capacity);
+            std::swap(_size, t._size);
+            std::swap(_growth_left, t._growth_left);
+            std::swap(_hash, t._hash);
+            std::swap(_eq, t._eq);
+        }
+
+        friend void swap(flat_table& a, flat_table& b) noexcept
+        {
+            a.swap(b);
+        }
+
+        iterator begin() noexcept
+        {
+            iterator i = iterator_at(0);
+            i.skip();
+            return i;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            const_iterator i = iterator_at(0);
+            i.skip();
+            return i;
+        }
+
+        iterator end() noexcept
+        {
+            return iterator_at(_capacity);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return iterator_at(_capacity);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (~size_type(0) >> 1) / (sizeof(slot_type) + 1);
+        }
+
+        float load_factor() const noexcept
+        {
+            return _capacity == 0 ? 0.0f : float(_size) / float(_capacity);
+        }
+
+        hasher hash_function() const
+        {
+            return _hash;
+        }
+
+        key_equal key_eq() const
+        {
+            return _eq;
+        }
+
+        /**
+         * @brief Makes room for n elements without rehashing
+         *
+         * @param n The number of elements
+         */
+        void reserve(size_type n)
+        {
+            if (n <= _size + _growth_left) return;
+            if (n > max_size()) throw std::length_error("eop::flat_table::reserve");
+            resize(normalize_capacity(growth_to_capacity(n)));
+        }
+
+        /**
+         * @brief Destroys every element, keeping the allocation
+         *
+         */
+        void clear() noexcept
+        {
+            destroy_all();
+            _size = 0;
+            if (_capacity != 0) reset_ctrl();
+        }
+
+        std::pair<iterator, bool> insert(const value_type& v)
+        {
+            return find_or_emplace(Policy::key(v), v);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& v)
+        {
+            return find_or_emplace(Policy::key(v), std::move(v));
+        }
+
+        template< std::input_iterator I, std::sentinel_for<I> S >
+        void insert(I f, S l)
+        {
+            for (; f != l; ++f) insert(*f);
+        }
+
+        void insert(std::initializer_list<value_type> l)
+        {
+            insert(l.begin(), l.end());
+        }
+
+        /**
+         * @brief Constructs an element from args and inserts it
+         * unless an equal key is present
+         *
+         */
+        template< class... Args >
+        std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            slot_type s(std::forward<Args>(args)...);
+            return find_or_emplace(Policy::key(s), std::move(s));
+        }
+
+        iterator find(const key_type& k) noexcept
+        {
+            size_type i = find_index(k, hash_of(k));
+            return i == npos ? end() : iterator_at(i);
+        }
+
+        const_iterator find(const key_type& k) const noexcept
+        {
+            size_type i = find_index(k, hash_of(k));
+            return i == npos ? end() : iterator_at(i);
+        }
+
+        template< class Q >
+            requires eop::transparent_lookup<H, Eq>
+        iterator find(const Q& k) noexcept
+        {
+            size_type i = find_index(k, hash_of(k));
+            return i == npos ? end() : iterator_at(i);
+        }
+
+        template< class Q >
+            requires eop::transparent_lookup<H, Eq>
+        const_iterator find(const Q& k) const noexcept
+        {
+            size_type i = find_index(k, hash_of(k));
+            return i == npos ? end() : iterator_at(i);
+        }
+
+        bool contains(const key_type& k) const noexcept
+        {
+            return find_index(k, hash_of(k)) != npos;
+        }
+
+        template< class Q >
+            requires eop::transparent_lookup<H, Eq>
+        bool contains(const Q& k) const noexcept
+        {
+            return find_index(k, hash_of(k)) != npos;
+        }
+
+        size_type count(const key_type& k) const noexcept
+        {
+            return size_type(contains(k));
+        }
+
+        template< class Q >
+            requires eop::transparent_lookup<H, Eq>
+        size_type count(const Q& k) const noexcept
+        {
+            return size_type(contains(k));
+        }
+
+        /**
+         * @brief Erases the element at i
+         *
+         * @param i An iterator to an element
+         * @return iterator The iterator following i
+         */
+        iterator erase(const_iterator i) noexcept
+        {
+            size_type n = size_type(i._c - _ctrl);
+            erase_at(n);
+            iterator j = iterator_at(n);
+            ++j;
+            return j;
+        }
+
+        size_type erase(const key_type& k) noexcept
+        {
+            size_type i = find_index(k, hash_of(k));
+            if (i == npos) return 0;
+            erase_at(i);
+            return 1;
+        }
+
+        template< class Q >
+            requires eop::transparent_lookup<H, Eq>
+                && (!std::is_convertible_v<Q, const_iterator>)
+        size_type erase(const Q& k) noexcept
+        {
+            size_type i = find_index(k, hash_of(k));
+            if (i == npos) return 0;
+            erase_at(i);
+            return 1;
+        }
+
+        friend bool operator==(const flat_table& a, const flat_table& b)
+        {
+            if (a._size != b._size) return false;
+            for (const value_type& x : a)
+            {
+                const_iterator i = b.find(Policy::key(x));
+                if (i == b.end() || !(*i == x)) return false;
+            }
+            return true;
+        }
+    };
+
+    template< regular _Tp >
+    struct flat_set_policy
+    {
+        using key_type = _Tp;
+        using value_type = _Tp;
+        using slot_type = _Tp;
+
+        static const _Tp& key(const _Tp& x) noexcept
+        {
+            return x;
+        }
+
+        static const _Tp& element(const _Tp& x) noexcept
+        {
+            return x;
+        }
+    };
+
+    /**
+     * @brief Slots of a flat map hold std::pair<K, V> so that
+     * keys can be moved when the table grows; elements are
+     * viewed as std::pair<const K, V>, of the same layout, so that
+     * keys cannot be modified in place
+     *
+     */
+    template< regular K, regular V >
+    struct flat_map_policy
+    {
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<const K, V>;
+        using slot_type = std::pair<K, V>;
+
+        template< class P >
+        static const K& key(const P& p) noexcept
+        {
+            return p.first;
+        }
+
+        static value_type& element(slot_type& s) noexcept
+        {
+            return *std::launder(reinterpret_cast<value_type*>(&s));
+        }
+
+        static const value_type& element(const slot_type& s) noexcept
+        {
+            return *std::launder(reinterpret_cast<const value_type*>(&s));
+        }
+    };
+
+    /**
+     * @brief Flat open-addressing hash set of a regular type
+     *
+     * E.g. the set of elements visited by an orbit, or seen by a
+     * deduplicating pass. Elements live in one contiguous
+     * allocation with their control bytes, and are immutable
+     * through iterators.
+     *
+     * @tparam _Tp A regular type
+     * @tparam H A hash function type for _Tp
+     * @tparam Eq An equality type for _Tp
+     */
+    template< regular _Tp, class H = eop::hash<_Tp>, class Eq = std::equal_to<> >
+    class flat_set : public eop::flat_table<eop::flat_set_policy<_Tp>, H, Eq>
+    {
+    private:
+        using base = eop::flat_table<eop::flat_set_policy<_Tp>, H, Eq>;
+
+    public:
+        using base::base;
+
+        flat_set() = default;
+
+        flat_set(std::initializer_list<_Tp> l)
+        {
+            this->reserve(l.size());
+            this->insert(l);
+        }
+
+        template< std::input_iterator I, std::sentinel_for<I> S >
+        flat_set(I f, S l)
+        {
+            if constexpr (std::sized_sentinel_for<S, I>)
+                this->reserve(std::size_t(l - f));
+            this->insert(f, l);
+        }
+    };
+
+    /**
+     * @brief Flat open-addressing hash map from a regular type
+     *
+     * Elements are std::pair<const K, V>, in one contiguous
+     * allocation with their control bytes.
+     *
+     * @tparam K A regular key type
+     * @tparam V A regular mapped type
+     * @tparam H A hash function type for K
+     * @tparam Eq An equality type for K
+     */
+    template< regular K, regular V, class H = eop::hash<K>, class Eq = std::equal_to<> >
+    class flat_map : public eop::flat_table<eop::flat_map_policy<K, V>, H, Eq>
+    {
+    private:
+        using base = eop::flat_table<eop::flat_map_policy<K, V>, H, Eq>;
+
+    public:
+        using mapped_type = V;
+        using typename base::iterator;
+        using typename base::size_type;
+
+        using base::base;
+
+        flat_map() = default;
+
+        flat_map(std::initializer_list<typename base::value_type> l)
+        {
+            this->reserve(l.size());
+            this->insert(l);
+        }
+
+        template< std::input_iterator I, std::sentinel_for<I> S >
+        flat_map(I f, S l)
+        {
+            if constexpr (std::sized_sentinel_for<S, I>)
+                this->reserve(std::size_t(l - f));
+            this->insert(f, l);
+        }
+
+        /**
+         * @brief Inserts $(k, V(args...))$ unless k is present,
+         * constructing nothing otherwise
+         *
+         */
+        template< class... Args >
+        std::pair<iterator, bool> try_emplace(const K& k, Args&&... args)
+        {
+            return this->find_or_emplace(k, std::piecewise_construct,
+                std::forward_as_tuple(k), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template< class... Args >
+        std::pair<iterator, bool> try_emplace(K&& k, Args&&... args)
+        {
+            return this->find_or_emplace(k, std::piecewise_construct,
+                std::forward_as_tuple(std::move(k)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template< class M >
+        std::pair<iterator, bool> insert_or_assign(const K& k, M&& m)
+        {
+            std::pair<iterator, bool> r = try_emplace(k, std::forward<M>(m));
+            if (!r.second) r.first->second = std::forward<M>(m);
+            return r;
+        }
+
+        V& operator[](const K& k)
+        {
+            return try_emplace(k).first->second;
+        }
+
+        V& operator[](K&& k)
+        {
+            return try_emplace(std::move(k)).first->second;
+        }
+
+        V& at(const K& k)
+        {
+            iterator i = this->find(k);
+            if (i == this->end()) throw std::out_of_range("eop::flat_map::at");
+            return i->second;
+        }
+
+        const V& at(const K& k) const
+        {
+            auto i = this->find(k);
+            if (i == this->end()) throw std::out_of_range("eop::flat_map::at");
+            return i->second;
+        }
+    };
+} // namespace eop
+
+#endif // !EOP_FLAT_HASH_HPP
@@ -1,10 +1,378 @@
 #ifndef EOP_INTRINSICS_HPP
 #define EOP_INTRINSICS_HPP
 
-#include "concepts.hpp"
+#include "memory.hpp"
 
 namespace eop
 {
+    /**
+     * @brief Method for construction over a range
+     * 
+     * Types that are trivially default constructible need no
+     * code at all; other types are constructed in order, and if
+     * a constructor throws the elements already constructed are
+     * destroyed before the exception propagates.
+     * 
+     * Precondition: $[f, l)$ refers to raw memory, not objects
+     * Postcondition: $[f, l)$ holds partially-formed objects
+     * 
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param l Past the last position
+     */
+    template< forward_iterator I >
+    void construct_range(I f, I l)
+    {
+        using T = eop::iterator_value_type<I>;
+        static_assert(std::is_default_constructible_v<T>);
+        if constexpr (!std::is_trivially_default_constructible_v<T>)
+        {
+            I c = f;
+            try
+            {
+                for (; c != l; ++c) new (static_cast<void*>(std::addressof(*c))) T;
+            }
+            catch (...)
+            {
+                for (; f != c; ++f) std::addressof(*f)->~T();
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief Method for construction over a range, with an
+     * initializer for members
+     * 
+     * For trivially copyable types over raw pointers this is a
+     * fill: memset when all bytes of the value are equal (as for
+     * any single-byte type, or zero), a vectorizable store loop
+     * for scalars, and otherwise
+     * one copy that is doubled with memcpy up to a cache-sized
+     * block which is then replicated. Other types are constructed
+     * in order and rolled back if a constructor throws.
+     * 
+     * Precondition: $[f, l)$ refers to raw memory, not objects
+     * Postcondition: every element of $[f, l)$ equals initializer
+     * 
+     * @tparam I A forward iterator type
+     * @tparam U A type from which the value type is constructible
+     * @param f The first position
+     * @param l Past the last position
+     * @param initializer The initializer
+     */
+    template< forward_iterator I, constructible U >
+    void construct_range(I f, I l, const U& initializer)
+    {
+        using T = eop::iterator_value_type<I>;
+        static_assert(std::is_constructible_v<T, const U&>);
+        if constexpr (std::is_pointer_v<I> && std::is_trivially_copyable_v<T>
+            && std::is_trivially_destructible_v<T>)
+        {
+            std::size_t n = std::size_t(l - f);
+            if (n == 0) return;
+            const T v(initializer);
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &v, sizeof(T));
+            bool uniform = true;
+            for (std::size_t i = 1; i < sizeof(T); ++i) uniform = uniform && bytes[i] == bytes[0];
+            if (uniform)
+            {
+                std::memset(static_cast<void*>(f), bytes[0], n * sizeof(T));
+            }
+            else if constexpr (std::is_scalar_v<T>)
+            {
+                for (std::size_t i = 0; i < n; ++i) f[i] = v;
+            }
+            else
+            {
+                constexpr std::size_t block = 4096 / sizeof(T) ? 4096 / sizeof(T) : 1;
+                std::memcpy(static_cast<void*>(f), &v, sizeof(T));
+                std::size_t k = 1;
+                std::size_t b = n < block ? n : block;
+                for (; k < b; k = k + k)
+                    std::memcpy(static_cast<void*>(f + k), f,
+                        (k < b - k ? k : b - k) * sizeof(T));
+                for (k = b; k < n; k = k + b)
+                    std::memcpy(static_cast<void*>(f + k), f,
+                        (b < n - k ? b : n - k) * sizeof(T));
+            }
+        }
+        else
+        {
+            I c = f;
+            try
+            {
+                for (; c != l; ++c)
+                    new (static_cast<void*>(std::addressof(*c))) T(initializer);
+            }
+            catch (...)
+            {
+                for (; f != c; ++f) std::addressof(*f)->~T();
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief Method for copy construction of a range into raw
+     * memory
+     * 
+     * Trivially copyable types over raw pointers are copied with
+     * a single memcpy; other types are constructed in order and
+     * rolled back if a constructor throws.
+     * 
+     * Precondition: $[d, d + (l - f))$ refers to raw memory that
+     * does not overlap $[f, l)$
+     * Postcondition: it holds copies of $[f, l)$
+     * 
+     * @tparam I A forward iterator type
+     * @tparam O A forward iterator type
+     * @param f The first source position
+     * @param l Past the last source position
+     * @param d The first destination position
+     * @return O Past the last destination position
+     */
+    template< forward_iterator I, forward_iterator O >
+    O copy_construct_range(I f, I l, O d)
+    {
+        using T = eop::iterator_value_type<O>;
+        if constexpr (std::is_pointer_v<I> && std::is_pointer_v<O>
+            && std::is_same_v<std::remove_cv_t<eop::iterator_value_type<I>>, T>
+            && std::is_trivially_copyable_v<T>)
+        {
+            std::size_t n = std::size_t(l - f);
+            if (n != 0) std::memcpy(static_cast<void*>(d), f, n * sizeof(T));
+            return d + n;
+        }
+        else
+        {
+            O c = d;
+            try
+            {
+                for (; f != l; ++f, ++c)
+                    new (static_cast<void*>(std::addressof(*c))) T(*f);
+            }
+            catch (...)
+            {
+                for (; d != c; ++d) std::addressof(*d)->~T();
+                throw;
+            }
+            return c;
+        }
+    }
+
+    /**
+     * @brief Method for destruction over a range
+     * 
+     * A no-op for trivially destructible types.
+     * 
+     * Precondition: $[f, l)$ holds partially-formed objects
+     * Postcondition: $[f, l)$ refers to raw memory, not objects
+     * 
+     * @tparam I A forward iterator type
+     * @param f The first position
+     * @param l Past the last position
+     */
+    template< forward_iterator I >
+    void destruct_range(I f, I l) noexcept
+    {
+        using T = eop::iterator_value_type<I>;
+        static_assert(std::is_destructible_v<T>);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for (; f != l; ++f) std::addressof(*f)->~T();
+        }
+    }
+
+    /**
+     * @brief Method for destruction over a range, with a finalizer
+     * 
+     * The finalizer is applied to each object before its
+     * destructor runs.
+     * 
+     * Precondition: $[f, l)$ holds partially-formed objects
+     * Postcondition: $[f, l)$ refers to raw memory, not objects
+     * 
+     * @tparam I A forward iterator type
+     * @tparam U A finalizer type
+     * @param f The first position
+     * @param l Past the last position
+     * @param finalizer The finalizer, passed by lvalue reference
+     */
+    template< forward_iterator I, typename U >
+    void destruct_range(I f, I l, U& finalizer)
+        noexcept(noexcept(finalizer(*f)))
+    {
+        using T = eop::iterator_value_type<I>;
+        static_assert(std::is_destructible_v<T>);
+        for (; f != l; ++f)
+        {
+            finalizer(*f);
+            std::addressof(*f)->~T();
+        }
+    }
+
+    /**
+     * @brief Method for relocation of an object: move
+     * construction at d followed by destruction of the source
+     * 
+     * Trivially relocatable types are copied bytewise, with no
+     * move constructor or destructor call.
+     * 
+     * Precondition: s holds an object, and d refers to raw memory
+     * Postcondition: d holds the object, and s refers to raw memory
+     * 
+     * @tparam _Tp A move constructible type
+     * @param s The source
+     * @param d The destination
+     * @return _Tp* The relocated object
+     */
+    template< class _Tp >
+    inline
+    _Tp* relocate_at(_Tp* s, _Tp* d)
+        noexcept(eop::is_trivially_relocatable_v<_Tp> || std::is_nothrow_move_constructible_v<_Tp>)
+    {
+        if constexpr (eop::is_trivially_relocatable_v<_Tp>)
+        {
+            std::memcpy(static_cast<void*>(d), static_cast<const void*>(s), sizeof(_Tp));
+            return std::launder(d);
+        }
+        else
+        {
+            _Tp* r = ::new (static_cast<void*>(d)) _Tp(std::move(*s));
+            s->~_Tp();
+            return r;
+        }
+    }
+
+    /**
+     * @brief Method for relocation of a range, e.g. into a grown
+     * buffer, or down over erased elements to compact one
+     * 
+     * Trivially relocatable types over raw pointers are moved
+     * with a single memmove, whichever way the ranges overlap.
+     * Other types are relocated one at a time in order; if a
+     * move constructor throws, the elements relocated so far stay
+     * at the destination and the others at the source.
+     * 
+     * Precondition: $[f, l)$ holds objects, and the destination
+     * refers to raw memory; with iterators other than pointers to
+     * trivially relocatable types, it starts at or before f, or
+     * does not overlap $[f, l)$
+     * Postcondition: the destination holds the objects of
+     * $[f, l)$, in order, and what is left of $[f, l)$ is raw memory
+     * 
+     * @tparam I A forward iterator type
+     * @tparam O A forward iterator type
+     * @param f The first source position
+     * @param l Past the last source position
+     * @param d The first destination position
+     * @return O Past the last destination position
+     */
+    template< forward_iterator I, forward_iterator O >
+    O relocate(I f, I l, O d)
+    {
+        using T = eop::iterator_value_type<O>;
+        if constexpr (std::is_pointer_v<I> && std::is_pointer_v<O>
+            && std::is_same_v<std::remove_cv_t<eop::iterator_value_type<I>>, T>
+            && eop::is_trivially_relocatable_v<T>)
+        {
+            std::size_t n = std::size_t(l - f);
+            if (n != 0) std::memmove(static_cast<void*>(d), static_cast<const void*>(f),
+                n * sizeof(T));
+            return d + n;
+        }
+        else
+        {
+            for (; f != l; ++f, ++d)
+            {
+                ::new (static_cast<void*>(std::addressof(*d))) T(std::move(*f));
+                std::addressof(*f)->~T();
+            }
+            return d;
+        }
+    }
+
+    /**
+     * @brief Method for relocation of a range, last element
+     * first, e.g. up to open a gap in a buffer
+     * 
+     * Precondition: as for eop::relocate, with the destination
+     * ending at or after l when the ranges overlap
+     * Postcondition: $[d - (l - f), d)$ holds the objects of
+     * $[f, l)$, in order
+     * 
+     * @tparam I A bidirectional iterator type
+     * @tparam O A bidirectional iterator type
+     * @param f The first source position
+     * @param l Past the last source position
+     * @param d Past the last destination position
+     * @return O The first destination position
+     */
+    template< bidirectional_iterator I, bidirectional_iterator O >
+    O relocate_backward(I f, I l, O d)
+    {
+        using T = eop::iterator_value_type<O>;
+        if constexpr (std::is_pointer_v<I> && std::is_pointer_v<O>
+            && std::is_same_v<std::remove_cv_t<eop::iterator_value_type<I>>, T>
+            && eop::is_trivially_relocatable_v<T>)
+        {
+            std::size_t n = std::size_t(l - f);
+            if (n != 0) std::memmove(static_cast<void*>(d - n), static_cast<const void*>(f),
+                n * sizeof(T));
+            return d - n;
+        }
+        else
+        {
+            while (l != f)
+            {
+                --l;
+                --d;
+                ::new (static_cast<void*>(std::addressof(*d))) T(std::move(*l));
+                std::addressof(*l)->~T();
+            }
+            return d;
+        }
+    }
+
+    /**
+     * @brief Detects contiguous containers, i.e. those with
+     * data() returning a raw pointer
+     * 
+     */
+    template< class C, class=void >
+    struct is_contiguous_container : std::false_type{};
+    template< class C >
+    struct is_contiguous_container<C,
+        typename std::enable_if<
+            std::is_pointer_v<decltype(std::data(std::declval<C&>()))>,
+            decltype(std::size(std::declval<C&>()), (void)0)>::type
+            > : std::true_type {};
+
+    /**
+     * @brief Bounds of a container, as raw pointers when the
+     * container is contiguous so that range methods can take
+     * their bulk paths
+     * 
+     * @tparam C A container type
+     * @param p The container
+     */
+    template< class C >
+    auto range_first(C& p) noexcept
+    {
+        if constexpr (eop::is_contiguous_container<C>::value) return std::data(p);
+        else return std::begin(p);
+    }
+
+    template< class C >
+    auto range_last(C& p) noexcept
+    {
+        if constexpr (eop::is_contiguous_container<C>::value)
+            return std::data(p) + std::size(p);
+        else return std::end(p);
+    }
+
     /**
      * @brief Method for construction
      * 
@@ -15,18 +383,14 @@ namespace eop
      * constructible types
      * @tparam _Tp A constructible type
      * @tparam Args Other constructible types
-     * @param p The container, passed by constant lvalue reference
+     * @param p The container, passed by lvalue reference
      */
     template < template< typename, typename... > class ContainerType,
                constructible _Tp, constructible... Args >
-    void construct(const ContainerType<_Tp, Args...>& p)
+    auto construct(ContainerType<_Tp, Args...>& p) -> decltype(std::begin(p), void())
     {
-        static_assert(std::is_constructible_v<_Tp>
-            && std::is_constructible_v<Args...>);
-        for (const auto& v : p)
-        {
-            new (&v) _Tp();
-        }
+        static_assert(std::is_constructible_v<_Tp>);
+        eop::construct_range(eop::range_first(p), eop::range_last(p));
     }
 
     /**
@@ -42,21 +406,18 @@ namespace eop
      * constructible types
      * @tparam _Tp A constructible type
      * @tparam Args Other constructible types
-     * @tparam U An
-     * @param p The container, passed by constant lvalue reference
+     * @tparam U An initializer type
+     * @param p The container, passed by lvalue reference
      * @param initializer The initializer, passed by constant lvalue
      * reference
      */
     template < template< typename, typename... > class ContainerType,
                constructible _Tp, constructible... Args, constructible U >
-    void construct(const ContainerType<_Tp, Args...>& p, const U& initializer)
+    auto construct(ContainerType<_Tp, Args...>& p, const U& initializer)
+        -> decltype(std::begin(p), void())
     {
-        static_assert(std::is_constructible_v<_Tp>
-            && std::is_constructible_v<Args...>);
-        for (const auto& v : p)
-        {
-            new (&v) _Tp(initializer);
-        }
+        static_assert(std::is_constructible_v<_Tp, const U&>);
+        eop::construct_range(eop::range_first(p), eop::range_last(p), initializer);
     }
 
     /**
@@ -69,18 +430,14 @@ namespace eop
      * destructible types
      * @tparam _Tp A destructible type
      * @tparam Args Other destructible types
-     * @param p The container, passed by constant lvalue reference
+     * @param p The container, passed by lvalue reference
      */
     template < template< typename, typename... > class ContainerType,
                destructible _Tp, destructible... Args >
-    void destruct(const ContainerType<_Tp, Args...>& p)
+    auto destruct(ContainerType<_Tp, Args...>& p) -> decltype(std::begin(p), void())
     {
-        static_assert(std::is_destructible_v<_Tp>
-            && std::is_destructible_v<Args...>);
-        for (const auto& v : p)
-        {
-            v.~_Tp();
-        }
+        static_assert(std::is_destructible_v<_Tp>);
+        eop::destruct_range(eop::range_first(p), eop::range_last(p));
     }
 
     /**
@@ -96,21 +453,103 @@ namespace eop
      * @tparam _Tp A destructible type
      * @tparam Args Other destructible types
      * @tparam U A finalizer
-     * @param p The container, passed by constant lvalue reference
+     * @param p The container, passed by lvalue reference
      * @param finalizer The finalizer, passed by lvalue reference
      */
     template< template< typename, typename... > class ContainerType,
               destructible _Tp, destructible... Args, destructible U >
-    void destruct(const ContainerType<_Tp, Args...>& p, U& finalizer)
+    auto destruct(ContainerType<_Tp, Args...>& p, U& finalizer)
+        -> decltype(std::begin(p), void())
+    {
+        static_assert(std::is_destructible_v<_Tp>);
+        eop::destruct_range(eop::range_first(p), eop::range_last(p), finalizer);
+    }
+
+    /**
+     * @brief Method for construction in an arena
+     * 
+     * Precondition: none; memory is taken from $a$
+     * Postcondition: the result points to a new object whose
+     * memory is reclaimed by $\func{reset}$ on $a$
+     * 
+     * @tparam _Tp A constructible type
+     * @tparam Args Argument types
+     * @param a The arena
+     * @param args Arguments
+     * @return _Tp* 
+     */
+    template< constructible _Tp, class... Args >
+    _Tp* construct(eop::arena& a, Args&&... args)
+    {
+        static_assert(std::is_constructible_v<_Tp, Args...>);
+        return new (a.allocate(sizeof(_Tp), alignof(_Tp)))
+            _Tp(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Method for construction in a pool
+     * 
+     * Postcondition: the result points to a new object in a
+     * slot of $p$; the slot is returned if construction throws
+     * 
+     * @tparam _Tp A constructible type
+     * @tparam Args Argument types
+     * @param p The pool
+     * @param args Arguments
+     * @return _Tp* 
+     */
+    template< constructible _Tp, class... Args >
+    _Tp* construct(eop::pool<_Tp>& p, Args&&... args)
     {
-        static_assert(std::is_destructible_v<_Tp>
-            && std::is_destructible_v<Args...>);
-        for (const auto& v : p)
+        static_assert(std::is_constructible_v<_Tp, Args...>);
+        _Tp* x = p.allocate();
+        try
         {
-            destruct(v);
+            return new (x) _Tp(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            p.deallocate(x);
+            throw;
         }
     }
 
+    /**
+     * @brief Method for destruction of an object in an arena
+     * 
+     * Precondition: $x$ was constructed in $a$
+     * Postcondition: $x$ refers to raw memory, owned by $a$
+     * 
+     * @tparam _Tp A destructible type
+     * @param a The arena
+     * @param x The object
+     */
+    template< destructible _Tp >
+    void destruct(eop::arena& a, _Tp* x) noexcept
+    {
+        static_assert(std::is_destructible_v<_Tp>);
+        (void)a;
+        x->~_Tp();
+    }
+
+    /**
+     * @brief Method for destruction of an object in a pool
+     * 
+     * Precondition: $x$ was constructed in $p$
+     * Postcondition: the slot of $x$ is free in $p$
+     * 
+     * @tparam _Tp A destructible type
+     * @param p The pool
+     * @param x The object
+     */
+    template< destructible _Tp >
+    void destruct(eop::pool<_Tp>& p, _Tp* x) noexcept
+    {
+        static_assert(std::is_destructible_v<_Tp>);
+        x->~_Tp();
+        p.deallocate(x);
+    }
+
     /**
      * @brief Prefix notation for a raw pointer
      * 
@@ -134,7 +573,10 @@ namespace eop
 
     /**
      * @brief Forwarding method to construct a unique
-     * pointer
+     * pointer to an object on the heap
+     * 
+     * Named apart from eop::shared_ptr_construct, since the two
+     * differ only in their return type
      * 
      * @tparam _Tp An object type for a partially formed object
      * from which a unique pointer is constructed
@@ -143,15 +585,15 @@ namespace eop
      * @return std::unique_ptr<_Tp> 
      */
     template< partially_formed _Tp, partially_formed... Args >
-    std::unique_ptr<_Tp> ptr_construct(Args&&... args)
+    std::unique_ptr<_Tp> unique_ptr_construct(Args&&... args)
     {
         static_assert(eop::is_partially_formed_v<_Tp>);
-        return std::unique_ptr<_Tp>(construct(_Tp(std::forward<Args>(args)...)));
+        return std::unique_ptr<_Tp>(new _Tp(std::forward<Args>(args)...));
     }
 
     /**
      * @brief Forwarding method to construct a shared
-     * pointer
+     * pointer to an object on the heap
      * 
      * @tparam _Tp An object type for a partially formed object from
      * which a shared pointer is constructed
@@ -160,10 +602,55 @@ namespace eop
      * @return std::shared_ptr<_Tp> 
      */
     template< partially_formed _Tp, partially_formed... Args >
-    std::shared_ptr<_Tp> ptr_construct(Args&&... args)
+    std::shared_ptr<_Tp> shared_ptr_construct(Args&&... args)
+    {
+        static_assert(eop::is_partially_formed_v<_Tp>);
+        return std::shared_ptr<_Tp>(new _Tp(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Forwarding method to construct a unique
+     * pointer to an object in an arena
+     * 
+     * The deleter runs the destructor only; the memory stays
+     * with the arena until it is reset. For shared ownership use
+     * std::allocate_shared with an eop::arena_allocator.
+     * 
+     * @tparam _Tp An object type for a partially formed object
+     * from which a unique pointer is constructed
+     * @tparam Args Argument types
+     * @param a The arena
+     * @param args Arguments
+     * @return std::unique_ptr<_Tp, eop::arena_deleter<_Tp>> 
+     */
+    template< partially_formed _Tp, partially_formed... Args >
+    std::unique_ptr<_Tp, eop::arena_deleter<_Tp>> ptr_construct(eop::arena& a,
+        Args&&... args)
+    {
+        static_assert(eop::is_partially_formed_v<_Tp>);
+        return std::unique_ptr<_Tp, eop::arena_deleter<_Tp>>(
+            eop::construct<_Tp>(a, std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Forwarding method to construct a unique
+     * pointer to an object in a pool
+     * 
+     * @tparam _Tp An object type for a partially formed object
+     * from which a unique pointer is constructed
+     * @tparam Args Argument types
+     * @param p The pool
+     * @param args Arguments
+     * @return std::unique_ptr<_Tp, eop::pool_deleter<_Tp>> 
+     */
+    template< partially_formed _Tp, partially_formed... Args >
+    std::unique_ptr<_Tp, eop::pool_deleter<_Tp>> ptr_construct(eop::pool<_Tp>& p,
+        Args&&... args)
     {
         static_assert(eop::is_partially_formed_v<_Tp>);
-        return std::shared_ptr<_Tp>(construct(_Tp(std::forward<Args>(args)...)));
+        return std::unique_ptr<_Tp, eop::pool_deleter<_Tp>>(
+            eop::construct(p, std::forward<Args>(args)...),
+            eop::pool_deleter<_Tp>{ &p });
     }
 } // namespace eop
 
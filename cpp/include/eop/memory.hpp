@@ -0,0 +1,740 @@
+#ifndef EOP_MEMORY_HPP
+#define EOP_MEMORY_HPP
+
+#include "concepts.hpp"
+
+/**
+ * @brief Linear handles carry a generation counter, checked on
+ * every access, in builds without NDEBUG. Define
+ * EOP_LINEAR_UNCHECKED to drop the checks there too, or
+ * EOP_LINEAR_CHECKED to keep them in release builds.
+ *
+ */
+#if !defined(EOP_LINEAR_CHECKED) && !defined(NDEBUG) && !defined(EOP_LINEAR_UNCHECKED)
+    #define EOP_LINEAR_CHECKED 1
+#endif
+
+namespace eop
+{
+    /**
+     * @brief Monotonic bump allocator over a chain of blocks
+     * 
+     * Allocation advances an offset in the current block, and
+     * moves on to the next retained block, or a new one, when the
+     * current block is exhausted. Individual deallocation is a
+     * no-op; $\func{reset}$ rewinds to the first block and keeps
+     * every block for reuse, so a steady workload stops touching
+     * the global heap after its first round.
+     * 
+     */
+    class arena
+    {
+    private:
+        struct block
+        {
+            std::byte* data;
+            std::size_t size;
+        };
+
+        std::vector<block> _blocks;
+        std::size_t _current = 0;
+        std::size_t _offset = 0;
+        std::size_t _block_size;
+        std::size_t _allocated = 0;
+
+        static std::size_t align_up(std::size_t n, std::size_t alignment) noexcept
+        {
+            return (n + alignment - 1) & ~(alignment - 1);
+        }
+
+        void* next_block(std::size_t bytes, std::size_t alignment)
+        {
+            while (++_current < _blocks.size())
+            {
+                std::byte* data = _blocks[_current].data;
+                std::size_t offset = align_up(std::size_t(data), alignment)
+                    - std::size_t(data);
+                if (offset + bytes <= _blocks[_current].size)
+                {
+                    _offset = offset + bytes;
+                    return data + offset;
+                }
+            }
+            std::size_t size = bytes + alignment > _block_size
+                ? bytes + alignment : _block_size;
+            std::byte* data = static_cast<std::byte*>(::operator new(size));
+            _blocks.push_back({ data, size });
+            _current = _blocks.size() - 1;
+            std::size_t offset = align_up(std::size_t(data), alignment)
+                - std::size_t(data);
+            _offset = offset + bytes;
+            return data + offset;
+        }
+
+    public:
+        /**
+         * @brief Creates an empty arena
+         * 
+         * @param block_size The size of each block requested
+         * from the global heap; larger requests get a block of
+         * their own
+         */
+        explicit arena(std::size_t block_size = 64 * 1024) noexcept
+            : _block_size(block_size) {}
+
+        arena(const arena&) = delete;
+        arena &operator=(const arena&) = delete;
+
+        ~arena()
+        {
+            release();
+        }
+
+        /**
+         * @brief Allocates raw memory
+         * 
+         * Precondition: alignment is a power of two
+         * 
+         * @param bytes The size in bytes
+         * @param alignment The alignment in bytes
+         * @return void* 
+         */
+        void* allocate(std::size_t bytes,
+            std::size_t alignment = alignof(std::max_align_t))
+        {
+            _allocated = _allocated + bytes;
+            if (_current < _blocks.size())
+            {
+                block& b = _blocks[_current];
+                std::size_t offset = align_up(std::size_t(b.data) + _offset, alignment)
+                    - std::size_t(b.data);
+                if (offset + bytes <= b.size)
+                {
+                    _offset = offset + bytes;
+                    return b.data + offset;
+                }
+            }
+            return next_block(bytes, alignment);
+        }
+
+        /**
+         * @brief Deallocation is deferred to $\func{reset}$
+         * 
+         */
+        void deallocate(void*, std::size_t) noexcept {}
+
+        /**
+         * @brief Makes all memory available again, without
+         * running destructors; retained blocks are reused
+         * 
+         */
+        void reset() noexcept
+        {
+            _current = 0;
+            _offset = 0;
+            _allocated = 0;
+        }
+
+        /**
+         * @brief Returns every block to the global heap
+         * 
+         */
+        void release() noexcept
+        {
+            for (const block& b : _blocks) ::operator delete(b.data);
+            _blocks.clear();
+            reset();
+        }
+
+        /**
+         * @brief Bytes handed out since the last reset
+         * 
+         * @return std::size_t 
+         */
+        std::size_t bytes_allocated() const noexcept
+        {
+            return _allocated;
+        }
+
+        /**
+         * @brief Bytes held from the global heap
+         * 
+         * @return std::size_t 
+         */
+        std::size_t capacity() const noexcept
+        {
+            std::size_t n = 0;
+            for (const block& b : _blocks) n = n + b.size;
+            return n;
+        }
+    };
+
+    /**
+     * @brief Standard allocator adaptor over an arena, for
+     * containers and std::allocate_shared
+     * 
+     * @tparam _Tp The value type
+     */
+    template< class _Tp >
+    struct arena_allocator
+    {
+        using value_type = _Tp;
+
+        eop::arena* source;
+
+        explicit arena_allocator(eop::arena& a) noexcept : source(&a) {}
+
+        template< class U >
+        arena_allocator(const arena_allocator<U>& x) noexcept : source(x.source) {}
+
+        _Tp* allocate(std::size_t n)
+        {
+            return static_cast<_Tp*>(source->allocate(n * sizeof(_Tp), alignof(_Tp)));
+        }
+
+        void deallocate(_Tp*, std::size_t) noexcept {}
+
+        template< class U >
+        friend
+        bool operator==(const arena_allocator& x, const arena_allocator<U>& y) noexcept
+        {
+            return x.source == y.source;
+        }
+
+        template< class U >
+        friend
+        bool operator!=(const arena_allocator& x, const arena_allocator<U>& y) noexcept
+        {
+            return x.source != y.source;
+        }
+    };
+
+    /**
+     * @brief Fixed-size free-list allocator for objects of
+     * one type
+     * 
+     * Slots are carved from chunks of slots_per_chunk at a time
+     * and recycled through an intrusive free list, so allocation
+     * and deallocation are a pointer swap each. Objects still
+     * alive when the pool is destroyed are not destructed.
+     * 
+     * @tparam _Tp The object type
+     */
+    template< class _Tp >
+    class pool
+    {
+    private:
+        union slot
+        {
+            slot* next;
+            alignas(_Tp) std::byte storage[sizeof(_Tp)];
+        };
+
+        std::vector<slot*> _chunks;
+        slot* _free = nullptr;
+        std::size_t _slots_per_chunk;
+        std::size_t _live = 0;
+
+        void grow()
+        {
+            slot* chunk = static_cast<slot*>(::operator new(
+                _slots_per_chunk * sizeof(slot), std::align_val_t(alignof(slot))));
+            _chunks.push_back(chunk);
+            for (std::size_t i = _slots_per_chunk; i != 0; --i)
+            {
+                chunk[i - 1].next = _free;
+                _free = &chunk[i - 1];
+            }
+        }
+
+    public:
+        /**
+         * @brief Creates an empty pool
+         * 
+         * @param slots_per_chunk The number of slots requested
+         * from the global heap at a time
+         */
+        explicit pool(std::size_t slots_per_chunk = 1024) noexcept
+            : _slots_per_chunk(slots_per_chunk ? slots_per_chunk : 1) {}
+
+        pool(const pool&) = delete;
+        pool &operator=(const pool&) = delete;
+
+        ~pool()
+        {
+            for (slot* c : _chunks)
+                ::operator delete(c, std::align_val_t(alignof(slot)));
+        }
+
+        /**
+         * @brief Allocates raw memory for one object
+         * 
+         * @return _Tp* 
+         */
+        _Tp* allocate()
+        {
+            if (!_free) grow();
+            slot* s = _free;
+            _free = s->next;
+            _live = _live + 1;
+            return reinterpret_cast<_Tp*>(s->storage);
+        }
+
+        /**
+         * @brief Returns the memory of one object to the pool
+         * 
+         * Precondition: p came from this pool and holds no object
+         * 
+         * @param p The memory
+         */
+        void deallocate(_Tp* p) noexcept
+        {
+            slot* s = reinterpret_cast<slot*>(p);
+            s->next = _free;
+            _free = s;
+            _live = _live - 1;
+        }
+
+        /**
+         * @brief The number of slots currently allocated
+         * 
+         * @return std::size_t 
+         */
+        std::size_t live() const noexcept
+        {
+            return _live;
+        }
+    };
+
+    /**
+     * @brief Raw memory for up to n objects, for the duration of
+     * an algorithm that runs faster with scratch space
+     *
+     * The request is halved until the allocation succeeds, so
+     * the buffer may be shorter than asked for, or empty;
+     * memory-adaptive algorithms take whatever $\func{size}$ it
+     * reports. The buffer holds no objects: whoever constructs
+     * objects in it destroys them.
+     *
+     * @tparam _Tp The object type
+     */
+    template< class _Tp >
+    class temporary_buffer
+    {
+    private:
+        static constexpr bool overaligned = alignof(_Tp) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        _Tp* _data = nullptr;
+        std::size_t _size = 0;
+
+    public:
+        /**
+         * @brief Allocates room for at most n objects
+         *
+         * @param n The number of objects wanted
+         */
+        explicit temporary_buffer(std::size_t n) noexcept
+        {
+            n = std::min(n, std::size_t(PTRDIFF_MAX) / sizeof(_Tp));
+            for (; n != 0; n = n / 2)
+            {
+                void* p;
+                if constexpr (overaligned)
+                    p = ::operator new(n * sizeof(_Tp), std::align_val_t(alignof(_Tp)),
+                        std::nothrow);
+                else
+                    p = ::operator new(n * sizeof(_Tp), std::nothrow);
+                if (p)
+                {
+                    _data = static_cast<_Tp*>(p);
+                    _size = n;
+                    break;
+                }
+            }
+        }
+
+        temporary_buffer(const temporary_buffer&) = delete;
+        temporary_buffer &operator=(const temporary_buffer&) = delete;
+
+        ~temporary_buffer()
+        {
+            if constexpr (overaligned)
+                ::operator delete(_data, std::align_val_t(alignof(_Tp)));
+            else
+                ::operator delete(_data);
+        }
+
+        _Tp* data() const noexcept
+        {
+            return _data;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _size;
+        }
+    };
+
+    /**
+     * @brief Deleter for objects placed in an arena; runs
+     * the destructor and leaves the memory to the arena
+     * 
+     * @tparam _Tp The object type
+     */
+    template< class _Tp >
+    struct arena_deleter
+    {
+        void operator()(_Tp* p) const noexcept
+        {
+            p->~_Tp();
+        }
+    };
+
+    /**
+     * @brief Deleter for objects placed in a pool; runs the
+     * destructor and returns the slot
+     * 
+     * @tparam _Tp The object type
+     */
+    template< class _Tp >
+    struct pool_deleter
+    {
+        eop::pool<_Tp>* source;
+
+        void operator()(_Tp* p) const noexcept
+        {
+            p->~_Tp();
+            source->deallocate(p);
+        }
+    };
+
+    /**
+     * @brief Reports a misuse of a linear handle in checked
+     * builds, and aborts
+     * 
+     * @param what The misuse
+     */
+    [[noreturn]]
+    inline
+    void linear_violation(const char* what) noexcept
+    {
+        std::fprintf(stderr, "eop: linear handle %s\n", what);
+        std::abort();
+    }
+
+    template< class _Tp >
+    class linear_slab;
+
+    /**
+     * @brief Move-only handle to an object in an
+     * eop::linear_slab, to be consumed or released exactly once
+     * 
+     * A handle is the index of its slot and nothing else in
+     * unchecked builds; in checked builds it also carries the
+     * generation of the slot when the object was placed, so that
+     * a handle used after its object was consumed, or forged
+     * from a stale raw value, is caught, as is a handle dropped
+     * without being consumed. Moving a handle leaves the source
+     * empty.
+     * 
+     * @tparam _Tp The object type
+     */
+    template< class _Tp >
+    class linear_handle
+    {
+    public:
+    #if defined(EOP_LINEAR_CHECKED)
+        using raw_type = std::uint64_t;
+    #else
+        using raw_type = std::uint32_t;
+    #endif
+
+    private:
+        static constexpr std::uint32_t empty = ~std::uint32_t(0);
+
+        std::uint32_t _index = empty;
+    #if defined(EOP_LINEAR_CHECKED)
+        std::uint32_t _generation = 0;
+    #endif
+
+        friend class eop::linear_slab<_Tp>;
+
+    public:
+        linear_handle() = default;
+
+        linear_handle(const linear_handle&) = delete;
+        linear_handle &operator=(const linear_handle&) = delete;
+
+        linear_handle(linear_handle&& x) noexcept
+            : _index(std::exchange(x._index, empty))
+        #if defined(EOP_LINEAR_CHECKED)
+            , _generation(x._generation)
+        #endif
+        {}
+
+        linear_handle &operator=(linear_handle&& x) noexcept
+        {
+        #if defined(EOP_LINEAR_CHECKED)
+            if (_index != empty) eop::linear_violation("overwritten without being consumed");
+            _generation = x._generation;
+        #endif
+            _index = std::exchange(x._index, empty);
+            return *this;
+        }
+
+    #if defined(EOP_LINEAR_CHECKED)
+        ~linear_handle()
+        {
+            if (_index != empty) eop::linear_violation("dropped without being consumed");
+        }
+    #endif
+
+        explicit operator bool() const noexcept
+        {
+            return _index != empty;
+        }
+
+        std::uint32_t index() const noexcept
+        {
+            return _index;
+        }
+
+        /**
+         * @brief Gives up the handle as a raw value, e.g. to pass
+         * it through a queue of integers
+         * 
+         * @return raw_type 
+         */
+        [[nodiscard]]
+        raw_type into_raw() && noexcept
+        {
+        #if defined(EOP_LINEAR_CHECKED)
+            return (raw_type(_generation) << 32) | std::exchange(_index, empty);
+        #else
+            return std::exchange(_index, empty);
+        #endif
+        }
+
+        /**
+         * @brief Takes back a handle given up by
+         * $\func{into_raw}$
+         * 
+         * Precondition: r came from $\func{into_raw}$ and is
+         * taken back once
+         * 
+         * @param r A raw value
+         * @return linear_handle 
+         */
+        [[nodiscard]]
+        static linear_handle from_raw(raw_type r) noexcept
+        {
+            linear_handle h;
+            h._index = std::uint32_t(r);
+        #if defined(EOP_LINEAR_CHECKED)
+            h._generation = std::uint32_t(r >> 32);
+        #endif
+            return h;
+        }
+    };
+
+    template< class _Tp >
+    struct is_trivially_relocatable<eop::linear_handle<_Tp>> : std::true_type {};
+
+    /**
+     * @brief Preallocated slab of slots for objects passed by
+     * linear handles
+     * 
+     * All storage is allocated on construction; placing an
+     * object pops a free slot index and consuming it pushes the
+     * index back, so a handoff costs no heap traffic and a handle
+     * is a 32-bit index. The slab is not synchronized: placing,
+     * consuming and releasing must not race, while objects in
+     * different slots may be used from different threads.
+     * Objects still in the slab when it is destroyed are
+     * destroyed with it.
+     * 
+     * Precondition: capacity is below $2^{32} - 1$
+     * 
+     * @tparam _Tp The object type
+     */
+    template< class _Tp >
+    class linear_slab
+    {
+    public:
+        using handle = eop::linear_handle<_Tp>;
+
+    private:
+        struct slot
+        {
+            alignas(_Tp) std::byte storage[sizeof(_Tp)];
+        };
+
+        std::unique_ptr<slot[]> _slots;
+        std::unique_ptr<std::uint32_t[]> _free;
+    #if defined(EOP_LINEAR_CHECKED)
+        // Odd while the slot holds an object
+        std::unique_ptr<std::uint32_t[]> _generation;
+    #endif
+        std::uint32_t _capacity;
+        std::uint32_t _top;
+
+        _Tp* object(std::uint32_t i) noexcept
+        {
+            return std::launder(reinterpret_cast<_Tp*>(_slots[i].storage));
+        }
+
+        void check(const handle& h) const noexcept
+        {
+        #if defined(EOP_LINEAR_CHECKED)
+            if (h._index == handle::empty) eop::linear_violation("used while empty");
+            if (h._index >= _capacity || _generation[h._index] != h._generation)
+                eop::linear_violation("used after its object was consumed");
+        #else
+            (void)h;
+        #endif
+        }
+
+        void free(handle& h) noexcept
+        {
+        #if defined(EOP_LINEAR_CHECKED)
+            _generation[h._index] = _generation[h._index] + 1;
+        #endif
+            _free[_top++] = std::exchange(h._index, handle::empty);
+        }
+
+    public:
+        /**
+         * @brief Allocates a slab of capacity slots
+         * 
+         * @param capacity The largest number of live objects
+         */
+        explicit linear_slab(std::uint32_t capacity)
+            : _slots(new slot[capacity]), _free(new std::uint32_t[capacity]),
+        #if defined(EOP_LINEAR_CHECKED)
+              _generation(new std::uint32_t[capacity]()),
+        #endif
+              _capacity(capacity), _top(capacity)
+        {
+            for (std::uint32_t i = 0; i < capacity; ++i) _free[i] = capacity - 1 - i;
+        }
+
+        linear_slab(const linear_slab&) = delete;
+        linear_slab &operator=(const linear_slab&) = delete;
+
+        ~linear_slab()
+        {
+            if constexpr (!std::is_trivially_destructible_v<_Tp>)
+            {
+                std::vector<bool> live(_capacity, true);
+                for (std::uint32_t k = 0; k < _top; ++k) live[_free[k]] = false;
+                for (std::uint32_t i = 0; i < _capacity; ++i)
+                    if (live[i]) object(i)->~_Tp();
+            }
+        }
+
+        std::uint32_t capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        /**
+         * @brief The number of objects in the slab
+         * 
+         * @return std::uint32_t 
+         */
+        std::uint32_t live() const noexcept
+        {
+            return _capacity - _top;
+        }
+
+        /**
+         * @brief Constructs an object in a free slot, or returns
+         * an empty handle if the slab is full
+         * 
+         * @tparam Args Constructor argument types
+         * @param args Constructor arguments
+         * @return handle 
+         */
+        template< class... Args >
+        [[nodiscard]]
+        handle try_emplace(Args&&... args)
+        {
+            handle h;
+            if (_top == 0) return h;
+            std::uint32_t i = _free[_top - 1];
+            ::new (static_cast<void*>(_slots[i].storage)) _Tp(std::forward<Args>(args)...);
+            --_top;
+            h._index = i;
+        #if defined(EOP_LINEAR_CHECKED)
+            h._generation = _generation[i] = _generation[i] + 1;
+        #endif
+            return h;
+        }
+
+        /**
+         * @brief Constructs an object in a free slot
+         * 
+         * @tparam Args Constructor argument types
+         * @param args Constructor arguments
+         * @return handle 
+         */
+        template< class... Args >
+        [[nodiscard]]
+        handle emplace(Args&&... args)
+        {
+            if (_top == 0) throw std::bad_alloc();
+            return try_emplace(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief The object of a handle, which stays live
+         * 
+         * @param h A handle from this slab
+         * @return _Tp& 
+         */
+        _Tp& operator[](const handle& h) noexcept
+        {
+            check(h);
+            return *object(h._index);
+        }
+
+        const _Tp& operator[](const handle& h) const noexcept
+        {
+            check(h);
+            return *std::launder(reinterpret_cast<const _Tp*>(_slots[h._index].storage));
+        }
+
+        /**
+         * @brief Moves the object of a handle out and frees its
+         * slot, consuming the handle
+         * 
+         * @param h A handle from this slab
+         * @return _Tp 
+         */
+        [[nodiscard]]
+        _Tp consume(handle&& h) noexcept(std::is_nothrow_move_constructible_v<_Tp>)
+        {
+            check(h);
+            _Tp* p = object(h._index);
+            _Tp x(std::move(*p));
+            p->~_Tp();
+            free(h);
+            return x;
+        }
+
+        /**
+         * @brief Destroys the object of a handle and frees its
+         * slot, consuming the handle
+         * 
+         * @param h A handle from this slab
+         */
+        void release(handle&& h) noexcept
+        {
+            check(h);
+            object(h._index)->~_Tp();
+            free(h);
+        }
+    };
+} // namespace eop
+
+#endif // !EOP_MEMORY_HPP
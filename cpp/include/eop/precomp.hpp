@@ -1,15 +1,49 @@
 #ifndef EOP_PRECOMP_HPP
 #define EOP_PRECOMP_HPP
 
-// #include <concepts> -- When it's here.
+#include <bit>
+#include <concepts>
 #include <new>
 #include <iterator>
+#include <ranges>
 #include <math.h>
+#include <cmath>
 #include <type_traits>
 #include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <optional>
+#include <numeric>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <initializer_list>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 #endif // !EOP_PRECOMP_HPP
\ No newline at end of file
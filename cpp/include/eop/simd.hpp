@@ -0,0 +1,260 @@
+#ifndef EOP_SIMD_HPP
+#define EOP_SIMD_HPP
+
+#include "concepts.hpp"
+
+/**
+ * @brief SIMD paths are compiled for x86-64 with GCC-compatible
+ * compilers, where SSE2 is baseline and wider instruction sets
+ * are enabled per function and selected at run time. Define
+ * EOP_SIMD_DISABLE to force the scalar fallbacks everywhere.
+ * 
+ */
+#if !defined(EOP_SIMD_DISABLE) && defined(__GNUC__) && defined(__x86_64__)
+    #define EOP_SIMD_X86 1
+    #define EOP_ALWAYS_INLINE __attribute__((always_inline))
+    #define EOP_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #define EOP_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace eop
+{
+    /**
+     * @brief Hints that the cache line at p is about to be read
+     * 
+     * @param p An address, not necessarily valid
+     */
+    inline
+    void prefetch(const void* p) noexcept
+    {
+    #if defined(__GNUC__)
+        __builtin_prefetch(p, 0, 3);
+    #else
+        (void)p;
+    #endif
+    }
+
+    /**
+     * @brief Instruction set levels for which vector
+     * kernels exist, in increasing order of width
+     * 
+     */
+    enum class simd_level : unsigned
+    {
+        scalar = 0,
+        sse2 = 1,
+        avx2 = 2,
+        avx512 = 3
+    };
+
+    /**
+     * @brief Queries the processor for the widest supported
+     * instruction set level
+     * 
+     * @return eop::simd_level 
+     */
+    inline
+    eop::simd_level simd_detect() noexcept
+    {
+    #if defined(EOP_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return eop::simd_level::avx512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return eop::simd_level::avx2;
+        return eop::simd_level::sse2;
+    #else
+        return eop::simd_level::scalar;
+    #endif
+    }
+
+    /**
+     * @brief The widest supported instruction set level,
+     * detected once per process
+     * 
+     * @return eop::simd_level 
+     */
+    inline
+    eop::simd_level simd_active_level() noexcept
+    {
+        static const eop::simd_level level = eop::simd_detect();
+        return level;
+    }
+
+    /**
+     * @brief Clamps a requested instruction set level to
+     * the one supported by the processor
+     * 
+     * @param requested The requested level
+     * @return eop::simd_level 
+     */
+    inline
+    eop::simd_level simd_clamp(eop::simd_level requested) noexcept
+    {
+        eop::simd_level active = eop::simd_active_level();
+        return requested < active ? requested : active;
+    }
+
+    /**
+     * @brief Lane operations of a vector register holding
+     * elements of an arithmetic type at some instruction set
+     * level; specialized for float and double
+     * 
+     * Each specialization provides vector_type, width, zero,
+     * broadcast, load, store, add, sub, mul, fmadd ($a b + c$),
+     * fmsub ($a b - c$), sqrt and hsum (horizontal sum). Kernels
+     * using them must carry the matching target attribute. The
+     * AVX-512 members avoid intrinsics built on undefined
+     * registers, which warn spuriously at -O0 on some GCC releases.
+     * 
+     * @tparam L An instruction set level
+     * @tparam _Tp An arithmetic type
+     */
+    template< eop::simd_level L, arithmetic _Tp >
+    struct simd_lanes {};
+
+#if defined(EOP_SIMD_X86)
+    template<>
+    struct simd_lanes<eop::simd_level::sse2, double>
+    {
+        using vector_type = __m128d;
+        static constexpr std::size_t width = 2;
+
+        EOP_ALWAYS_INLINE static inline vector_type zero() noexcept { return _mm_setzero_pd(); }
+        EOP_ALWAYS_INLINE static inline vector_type broadcast(double x) noexcept { return _mm_set1_pd(x); }
+        EOP_ALWAYS_INLINE static inline vector_type load(const double* p) noexcept { return _mm_loadu_pd(p); }
+        EOP_ALWAYS_INLINE static inline void store(double* p, vector_type a) noexcept { _mm_storeu_pd(p, a); }
+        EOP_ALWAYS_INLINE static inline vector_type add(vector_type a, vector_type b) noexcept { return _mm_add_pd(a, b); }
+        EOP_ALWAYS_INLINE static inline vector_type sub(vector_type a, vector_type b) noexcept { return _mm_sub_pd(a, b); }
+        EOP_ALWAYS_INLINE static inline vector_type mul(vector_type a, vector_type b) noexcept { return _mm_mul_pd(a, b); }
+        EOP_ALWAYS_INLINE static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+        EOP_ALWAYS_INLINE static inline vector_type fmsub(vector_type a, vector_type b, vector_type c) noexcept { return _mm_sub_pd(_mm_mul_pd(a, b), c); }
+        EOP_ALWAYS_INLINE static inline vector_type sqrt(vector_type a) noexcept { return _mm_sqrt_pd(a); }
+        EOP_ALWAYS_INLINE static inline double hsum(vector_type a) noexcept
+        {
+            return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+        }
+    };
+
+    template<>
+    struct simd_lanes<eop::simd_level::sse2, float>
+    {
+        using vector_type = __m128;
+        static constexpr std::size_t width = 4;
+
+        EOP_ALWAYS_INLINE static inline vector_type zero() noexcept { return _mm_setzero_ps(); }
+        EOP_ALWAYS_INLINE static inline vector_type broadcast(float x) noexcept { return _mm_set1_ps(x); }
+        EOP_ALWAYS_INLINE static inline vector_type load(const float* p) noexcept { return _mm_loadu_ps(p); }
+        EOP_ALWAYS_INLINE static inline void store(float* p, vector_type a) noexcept { _mm_storeu_ps(p, a); }
+        EOP_ALWAYS_INLINE static inline vector_type add(vector_type a, vector_type b) noexcept { return _mm_add_ps(a, b); }
+        EOP_ALWAYS_INLINE static inline vector_type sub(vector_type a, vector_type b) noexcept { return _mm_sub_ps(a, b); }
+        EOP_ALWAYS_INLINE static inline vector_type mul(vector_type a, vector_type b) noexcept { return _mm_mul_ps(a, b); }
+        EOP_ALWAYS_INLINE static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        EOP_ALWAYS_INLINE static inline vector_type fmsub(vector_type a, vector_type b, vector_type c) noexcept { return _mm_sub_ps(_mm_mul_ps(a, b), c); }
+        EOP_ALWAYS_INLINE static inline vector_type sqrt(vector_type a) noexcept { return _mm_sqrt_ps(a); }
+        EOP_ALWAYS_INLINE static inline float hsum(vector_type a) noexcept
+        {
+            vector_type b = _mm_add_ps(a, _mm_movehl_ps(a, a));
+            return _mm_cvtss_f32(_mm_add_ss(b, _mm_shuffle_ps(b, b, 1)));
+        }
+    };
+
+    template<>
+    struct simd_lanes<eop::simd_level::avx2, double>
+    {
+        using vector_type = __m256d;
+        static constexpr std::size_t width = 4;
+
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type zero() noexcept { return _mm256_setzero_pd(); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type broadcast(double x) noexcept { return _mm256_set1_pd(x); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline void store(double* p, vector_type a) noexcept { _mm256_storeu_pd(p, a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type add(vector_type a, vector_type b) noexcept { return _mm256_add_pd(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type sub(vector_type a, vector_type b) noexcept { return _mm256_sub_pd(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type mul(vector_type a, vector_type b) noexcept { return _mm256_mul_pd(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type fmsub(vector_type a, vector_type b, vector_type c) noexcept { return _mm256_fmsub_pd(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type sqrt(vector_type a) noexcept { return _mm256_sqrt_pd(a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline double hsum(vector_type a) noexcept
+        {
+            __m128d b = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(b, _mm_unpackhi_pd(b, b)));
+        }
+    };
+
+    template<>
+    struct simd_lanes<eop::simd_level::avx2, float>
+    {
+        using vector_type = __m256;
+        static constexpr std::size_t width = 8;
+
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type zero() noexcept { return _mm256_setzero_ps(); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type broadcast(float x) noexcept { return _mm256_set1_ps(x); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline void store(float* p, vector_type a) noexcept { _mm256_storeu_ps(p, a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type add(vector_type a, vector_type b) noexcept { return _mm256_add_ps(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type sub(vector_type a, vector_type b) noexcept { return _mm256_sub_ps(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type mul(vector_type a, vector_type b) noexcept { return _mm256_mul_ps(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type fmsub(vector_type a, vector_type b, vector_type c) noexcept { return _mm256_fmsub_ps(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline vector_type sqrt(vector_type a) noexcept { return _mm256_sqrt_ps(a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX2 static inline float hsum(vector_type a) noexcept
+        {
+            __m128 b = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            b = _mm_add_ps(b, _mm_movehl_ps(b, b));
+            return _mm_cvtss_f32(_mm_add_ss(b, _mm_shuffle_ps(b, b, 1)));
+        }
+    };
+
+    template<>
+    struct simd_lanes<eop::simd_level::avx512, double>
+    {
+        using vector_type = __m512d;
+        static constexpr std::size_t width = 8;
+
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type zero() noexcept { return _mm512_setzero_pd(); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type broadcast(double x) noexcept { return _mm512_set1_pd(x); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline void store(double* p, vector_type a) noexcept { _mm512_storeu_pd(p, a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type add(vector_type a, vector_type b) noexcept { return _mm512_add_pd(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type sub(vector_type a, vector_type b) noexcept { return _mm512_sub_pd(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type mul(vector_type a, vector_type b) noexcept { return _mm512_mul_pd(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type fmsub(vector_type a, vector_type b, vector_type c) noexcept { return _mm512_fmsub_pd(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type sqrt(vector_type a) noexcept { return _mm512_maskz_sqrt_pd(0xFF, a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline double hsum(vector_type a) noexcept
+        {
+            alignas(64) double b[width];
+            _mm512_store_pd(b, a);
+            return ((b[0] + b[1]) + (b[2] + b[3])) + ((b[4] + b[5]) + (b[6] + b[7]));
+        }
+    };
+
+    template<>
+    struct simd_lanes<eop::simd_level::avx512, float>
+    {
+        using vector_type = __m512;
+        static constexpr std::size_t width = 16;
+
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type zero() noexcept { return _mm512_setzero_ps(); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type broadcast(float x) noexcept { return _mm512_set1_ps(x); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline void store(float* p, vector_type a) noexcept { _mm512_storeu_ps(p, a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type add(vector_type a, vector_type b) noexcept { return _mm512_add_ps(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type sub(vector_type a, vector_type b) noexcept { return _mm512_sub_ps(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type mul(vector_type a, vector_type b) noexcept { return _mm512_mul_ps(a, b); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type fmsub(vector_type a, vector_type b, vector_type c) noexcept { return _mm512_fmsub_ps(a, b, c); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline vector_type sqrt(vector_type a) noexcept { return _mm512_maskz_sqrt_ps(0xFFFF, a); }
+        EOP_ALWAYS_INLINE EOP_TARGET_AVX512 static inline float hsum(vector_type a) noexcept
+        {
+            alignas(64) float b[width];
+            _mm512_store_ps(b, a);
+            float r = 0.0f;
+            for (std::size_t i = 0; i < width; i += 2) r += b[i] + b[i + 1];
+            return r;
+        }
+    };
+#endif // EOP_SIMD_X86
+} // namespace eop
+
+#endif // !EOP_SIMD_HPP
@@ -0,0 +1,1211 @@
+/**
+ * @brief Behavior tests for the eop algorithms
+ * 
+ * Each test checks an algorithm against a direct computation or
+ * its standard library counterpart, on small inputs that run
+ * under the sanitizers in a fraction of a second. The harness is
+ * self-contained, so the tests build wherever the library does;
+ * pass test names as arguments to run only those.
+ * 
+ */
+// Keep the linear handle checks of memory.hpp in release builds
+#define EOP_LINEAR_CHECKED 1
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <forward_list>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "eop/ch-02/checkpointed_orbits.hpp"
+#include "eop/ch-02/composition.hpp"
+#include "eop/ch-02/distinguished_points.hpp"
+#include "eop/ch-02/interleaved_orbits.hpp"
+#include "eop/ch-02/jump_tables.hpp"
+#include "eop/ch-02/norms.hpp"
+#include "eop/ch-02/orbit_tables.hpp"
+#include "eop/ch-02/orbit_view.hpp"
+#include "eop/ch-02/tabulated.hpp"
+#include "eop/ch-02/transorbs.hpp"
+#include "eop/ch-03/assocops.hpp"
+#include "eop/ch-03/pollard_rho.hpp"
+#include "eop/ch-03/reductions.hpp"
+#include "eop/ch-10/rearrangements.hpp"
+#include "eop/ch-11/partitions.hpp"
+#include "eop/executor.hpp"
+#include "eop/flat_hash.hpp"
+#include "eop/instrumented.hpp"
+#include "eop/intrinsics.hpp"
+#include "eop/memory.hpp"
+
+namespace eop_test
+{
+    struct test_case
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    inline std::vector<test_case>& registry()
+    {
+        static std::vector<test_case> r;
+        return r;
+    }
+
+    inline std::size_t failures = 0;
+
+    struct registrar
+    {
+        registrar(const char* name, void (*run)())
+        {
+            registry().push_back({ name, run });
+        }
+    };
+
+    inline void fail(const char* file, int line, const char* what)
+    {
+        ++failures;
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+    }
+} // namespace eop_test
+
+#define EOP_TEST(suite, name) \
+    static void suite##_##name(); \
+    static const eop_test::registrar suite##_##name##_registrar(#suite "." #name, suite##_##name); \
+    static void suite##_##name()
+
+#define EOP_CHECK(...) \
+    do { if (!(__VA_ARGS__)) eop_test::fail(__FILE__, __LINE__, #__VA_ARGS__); } while (0)
+
+#define EOP_CHECK_EQ(a, ...) \
+    do { if (!((a) == (__VA_ARGS__))) eop_test::fail(__FILE__, __LINE__, #a " == " #__VA_ARGS__); } while (0)
+
+namespace eop_test
+{
+    /**
+     * @brief $x \mapsto (x^2 + 1) \bmod m$, whose orbits have
+     * handles and cycles of varied sizes
+     * 
+     */
+    struct square_plus_one
+    {
+        std::uint32_t m;
+
+        std::uint32_t operator()(std::uint32_t x) const noexcept
+        {
+            return std::uint32_t((std::uint64_t(x) * x + 1) % m);
+        }
+    };
+
+    /**
+     * @brief $x \mapsto x + 1$ on 8 bits, one cycle through the
+     * whole domain
+     * 
+     */
+    struct inc8
+    {
+        constexpr std::uint8_t operator()(std::uint8_t x) const noexcept
+        {
+            return std::uint8_t(x + 1);
+        }
+    };
+
+    /**
+     * @brief $x \mapsto x + 1$ on 16 bits
+     * 
+     */
+    struct inc16
+    {
+        constexpr std::uint16_t operator()(std::uint16_t x) const noexcept
+        {
+            return std::uint16_t(x + 1);
+        }
+    };
+
+    /**
+     * @brief $x \mapsto 3x \bmod 8$, a permutation with cycles
+     * (0) (1 3) (2 6) (4) (5 7)
+     * 
+     */
+    struct times3_mod8
+    {
+        constexpr std::uint8_t operator()(std::uint8_t x) const noexcept
+        {
+            return std::uint8_t(3 * x % 8);
+        }
+    };
+
+    /**
+     * @brief $x \mapsto (x \mathbin{|} 1) + 1$, which merges $2k$
+     * and $2k + 1$
+     * 
+     */
+    struct round_up_even
+    {
+        std::uint64_t operator()(std::uint64_t x) const noexcept
+        {
+            return (x | 1) + 1;
+        }
+    };
+
+    /**
+     * @brief A distance type that is not integral, and only
+     * counts from small literals
+     * 
+     */
+    struct step_count
+    {
+        std::uint64_t value;
+
+        constexpr explicit step_count(int v) noexcept : value(std::uint64_t(v)) {}
+        step_count(std::uint64_t) = delete;
+
+        friend constexpr step_count operator+(step_count a, step_count b) noexcept
+        {
+            step_count r(0);
+            r.value = a.value + b.value;
+            return r;
+        }
+
+        friend constexpr bool operator==(step_count, step_count) noexcept = default;
+    };
+
+    /**
+     * @brief $x \mapsto x + 1$ on 16 bits, counting steps in
+     * eop_test::step_count
+     * 
+     */
+    struct inc16_counted : inc16 {};
+
+    /**
+     * @brief $x \mapsto table[x]$, a lookup that hints its next
+     * read
+     * 
+     */
+    struct table_step
+    {
+        const std::uint32_t* table;
+
+        std::uint32_t operator()(std::uint32_t x) const noexcept
+        {
+            return table[x];
+        }
+    };
+
+    /**
+     * @brief A file checkpoint that stops the walk right after
+     * its k-th save, as a crash would
+     * 
+     */
+    struct interrupting_checkpoint : eop::file_checkpoint
+    {
+        struct interrupted {};
+
+        std::uint64_t k;
+
+        interrupting_checkpoint(const std::filesystem::path& path, std::uint64_t steps,
+            std::uint64_t k)
+            : eop::file_checkpoint(path, steps), k(k) {}
+
+        template< class S >
+        void save(const S& s)
+        {
+            eop::file_checkpoint::save(s);
+            if (saves() == k) throw interrupted{};
+        }
+    };
+
+    /**
+     * @brief A value whose equality throws when both sides are
+     * negative
+     * 
+     */
+    struct picky
+    {
+        struct refused {};
+
+        int value;
+
+        friend bool operator==(picky a, picky b)
+        {
+            if (a.value < 0 && b.value < 0) throw refused{};
+            return a.value == b.value;
+        }
+    };
+
+    /**
+     * @brief The shape of the orbit of x by direct enumeration
+     * 
+     */
+    template< class F >
+    std::pair<std::uint64_t, std::uint64_t> naive_shape(eop::domain<F> x, F f)
+    {
+        std::vector<eop::domain<F>> seen;
+        while (std::find(seen.begin(), seen.end(), x) == seen.end())
+        {
+            seen.push_back(x);
+            x = f(x);
+        }
+        std::uint64_t h = std::uint64_t(std::find(seen.begin(), seen.end(), x) - seen.begin());
+        return { h, seen.size() - h };
+    }
+
+    /**
+     * @brief The error of x relative to a reference r, or its
+     * magnitude when r is zero
+     * 
+     */
+    template< class _Tp >
+    long double relative_error(_Tp x, long double r)
+    {
+        long double e = std::fabs(static_cast<long double>(x) - r);
+        return r == 0 ? e : e / std::fabs(r);
+    }
+
+#if defined(__unix__)
+    /**
+     * @brief Whether fn aborts, run in a child process so that
+     * the abort does not end the tests
+     * 
+     */
+    template< class Fn >
+    bool aborts(Fn fn)
+    {
+        std::fflush(nullptr);
+        pid_t pid = ::fork();
+        if (pid == 0)
+        {
+            std::freopen("/dev/null", "w", stderr);
+            fn();
+            std::_Exit(0);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+    }
+#endif
+} // namespace eop_test
+
+namespace eop
+{
+    template<>
+    struct input<eop_test::square_plus_one, 0>
+    {
+        using type = std::uint32_t;
+    };
+
+    template<>
+    struct input<eop_test::inc8, 0>
+    {
+        using type = std::uint8_t;
+    };
+
+    template<>
+    struct input<eop_test::inc16, 0>
+    {
+        using type = std::uint16_t;
+    };
+
+    template<>
+    struct input<eop_test::round_up_even, 0>
+    {
+        using type = std::uint64_t;
+    };
+
+    template<>
+    struct input<eop_test::times3_mod8, 0>
+    {
+        using type = std::uint8_t;
+    };
+
+    template<>
+    struct input<eop_test::inc16_counted, 0>
+    {
+        using type = std::uint16_t;
+    };
+
+    template<>
+    struct distance<eop_test::inc16_counted>
+    {
+        using type = eop_test::step_count;
+    };
+
+    template<>
+    struct input<eop_test::table_step, 0>
+    {
+        using type = std::uint32_t;
+    };
+
+    template<>
+    struct prefetch_hint<eop_test::table_step>
+    {
+        static void prefetch(const eop_test::table_step& f, std::uint32_t x) noexcept
+        {
+            eop::prefetch(f.table + x);
+        }
+    };
+} // namespace eop
+
+using namespace eop_test;
+
+EOP_TEST(founds, lexicographical_equal_lets_comparisons_throw)
+{
+    std::vector<int> a{ 1, 2, 3 };
+    std::vector<picky> x{ { 1 }, { -2 } }, y{ { 1 }, { -2 } };
+    static_assert(noexcept(eop::lexicographical_equal(a, a)));
+    static_assert(!noexcept(eop::lexicographical_equal(x, y)));
+    static_assert(!noexcept(eop::lexicographical_equal_all(x.begin(), x.end(), y.begin())));
+    EOP_CHECK(eop::lexicographical_equal(a.begin(), a.end(), a.begin(), a.end()));
+    bool thrown = false;
+    try
+    {
+        eop::lexicographical_equal(x, y);
+    }
+    catch (const picky::refused&)
+    {
+        thrown = true;
+    }
+    EOP_CHECK(thrown);
+}
+
+EOP_TEST(orbits, floyd_and_brent_agree_with_enumeration)
+{
+    square_plus_one f{ 1009 };
+    auto defined = [](std::uint32_t) { return true; };
+    for (std::uint32_t x = 0; x < 200; ++x)
+    {
+        auto [h, c] = naive_shape(x, f);
+        auto floyd = eop::orbit_structure(x, f, defined);
+        auto brent = eop::orbit_structure_brent(x, f, defined);
+        EOP_CHECK_EQ(floyd.m0, h);
+        EOP_CHECK_EQ(floyd.m1, c - 1);
+        EOP_CHECK_EQ(brent.m0, h);
+        EOP_CHECK_EQ(brent.m1, c - 1);
+        EOP_CHECK_EQ(brent.m2, floyd.m2);
+    }
+}
+
+EOP_TEST(orbits, brent_on_a_narrow_distance_type)
+{
+    // uint8_t distances: the cycle size minus one must not be
+    // computed in int and narrowed in the braced return
+    auto defined = [](std::uint8_t) { return true; };
+    auto s = eop::orbit_structure_brent(std::uint8_t(7), inc8{}, defined);
+    EOP_CHECK_EQ(s.m0, 0u);
+    EOP_CHECK_EQ(s.m1, 255u);
+    auto t = eop::orbit_structure_brent_nonterminating_orbit(std::uint16_t(0), inc16{});
+    EOP_CHECK_EQ(t.m0, 0u);
+    EOP_CHECK_EQ(t.m1, 65535u);
+}
+
+EOP_TEST(orbits, power_unary_and_distance)
+{
+    square_plus_one f{ 1009 };
+    std::uint32_t y = 5;
+    for (std::uint32_t n = 0; n < 20; ++n)
+    {
+        std::uint32_t z = eop::power_unary(std::uint32_t(3), n, f);
+        EOP_CHECK_EQ(z, y = n == 0 ? 3 : f(y));
+    }
+    EOP_CHECK_EQ(eop::orbit_distance(std::uint32_t(0), eop::power_unary(std::uint32_t(0), 7u, f), f), 7u);
+}
+
+EOP_TEST(orbits, distance_of_a_non_integral_type)
+{
+    auto d = eop::orbit_distance(std::uint16_t(10), std::uint16_t(5), inc16_counted{});
+    EOP_CHECK_EQ(d.value, 65531u);
+}
+
+EOP_TEST(norm_kernels, within_their_error_bounds)
+{
+    // approximate is the looser of the root errors stated for
+    // x86-64 and elsewhere
+    auto check = [](auto zero, long double approximate)
+    {
+        using T = decltype(zero);
+        using eop::norm_kernel;
+        const long double u = std::numeric_limits<T>::epsilon() / 2;
+        std::mt19937_64 g(6);
+        std::uniform_real_distribution<T> d(T(-4), T(4));
+        for (int i = 0; i < 10000; ++i)
+        {
+            T x = d(g), y = d(g), z = d(g);
+            long double r = std::sqrt(static_cast<long double>(x) * x
+                + static_cast<long double>(y) * y + static_cast<long double>(z) * z);
+            // (n + 1) / 2 ulp for n = 3, and an ulp is at most 2u
+            // relative to the result
+            EOP_CHECK(relative_error(eop::euclidean_norm<T, 3>()(x, y, z), r) <= 4 * u);
+            EOP_CHECK(relative_error(eop::euclidean_norm<T, 3, norm_kernel::scaled>()(x, y, z), r)
+                <= 4 * u);
+            EOP_CHECK(relative_error(eop::euclidean_norm<T, 3, norm_kernel::widened>()(x, y, z), r)
+                <= 2 * u);
+            EOP_CHECK(relative_error(eop::euclidean_norm<T, 3, norm_kernel::approximate>()(x, y, z), r)
+                <= approximate + 4 * u);
+        }
+    };
+    check(0.0f, std::ldexp(1.0L, -17));
+    check(0.0, std::ldexp(1.0L, -43));
+}
+
+EOP_TEST(norm_kernels, scaled_and_widened_beyond_the_range_of_squares)
+{
+    using eop::norm_kernel;
+    const long double u = std::numeric_limits<double>::epsilon() / 2;
+    for (int e : { -1000, -600, -300, 0, 300, 600, 1000 })
+    {
+        double x = std::ldexp(3.0, e), y = std::ldexp(4.0, e), z = std::ldexp(12.0, e);
+        long double r = std::ldexp(13.0L, e);
+        EOP_CHECK(relative_error(eop::euclidean_norm<double, 3, norm_kernel::scaled>()(x, y, z), r)
+            <= 4 * u);
+    }
+
+    // Float squares overflow beyond 2^64
+    float x = std::ldexp(3.0f, 100), y = std::ldexp(4.0f, 100);
+    EOP_CHECK(std::isinf(eop::euclidean_norm<float, 2>()(x, y)));
+    EOP_CHECK_EQ(std::ldexp(5.0f, 100), eop::euclidean_norm<float, 2, norm_kernel::scaled>()(x, y));
+    EOP_CHECK_EQ(std::ldexp(5.0f, 100), eop::euclidean_norm<float, 2, norm_kernel::widened>()(x, y));
+
+    // An infinity outweighs a NaN wherever it appears
+    double inf = std::numeric_limits<double>::infinity();
+    EOP_CHECK_EQ(inf, eop::norm<norm_kernel::scaled>(std::nan(""), inf, 1.0));
+    EOP_CHECK_EQ(inf, eop::norm<norm_kernel::scaled>(1.0, std::nan(""), -inf));
+}
+
+EOP_TEST(norms, every_level_agrees_with_a_wide_reference)
+{
+    auto check = [](auto zero)
+    {
+        using T = decltype(zero);
+        const long double u = std::numeric_limits<T>::epsilon() / 2;
+        std::mt19937_64 g(4);
+        std::uniform_real_distribution<T> d(T(-2), T(2));
+        // Lengths around the lane counts, to cover every tail
+        for (std::size_t n : { 0, 1, 3, 7, 8, 15, 16, 17, 33, 100, 1001 })
+        {
+            std::vector<T> x(n);
+            long double r = 0;
+            for (T& v : x)
+            {
+                v = d(g);
+                r += static_cast<long double>(v) * v;
+            }
+            for (unsigned l = 0; l <= unsigned(eop::simd_level::avx512); ++l)
+            {
+                auto level = eop::simd_level(l);
+                T a = eop::squared_norm_n(x.data(), n, eop::summation::naive, level);
+                T c = eop::squared_norm_n(x.data(), n, eop::summation::compensated, level);
+                T e = eop::euclidean_norm_n(x.data(), n, eop::summation::compensated, level);
+                EOP_CHECK(relative_error(a, r) <= (n + 1) * u);
+                EOP_CHECK(relative_error(c, r) <= 3 * u);
+                EOP_CHECK(relative_error(e, std::sqrt(r)) <= 3 * u);
+            }
+        }
+    };
+    check(0.0f);
+    check(0.0);
+
+    std::vector<int> v{ 1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11 };
+    for (unsigned l = 0; l <= unsigned(eop::simd_level::avx512); ++l)
+        EOP_CHECK_EQ(eop::squared_norm_n(v.data(), v.size(), eop::summation::naive,
+            eop::simd_level(l)), 506);
+}
+
+EOP_TEST(norms, structure_of_arrays_at_every_level)
+{
+    auto check = [](auto zero)
+    {
+        using T = decltype(zero);
+        const long double u = std::numeric_limits<T>::epsilon() / 2;
+        // 37 points leave a tail at every lane count
+        constexpr std::size_t dim = 3, n = 37;
+        std::mt19937_64 g(5);
+        std::uniform_real_distribution<T> d(T(-2), T(2));
+        std::vector<T> xs(dim * n), ys(dim * n);
+        for (T& v : xs) v = d(g);
+        for (T& v : ys) v = d(g);
+        const T* x[dim] = { &xs[0], &xs[n], &xs[2 * n] };
+        const T* y[dim] = { &ys[0], &ys[n], &ys[2 * n] };
+        std::vector<long double> norms(n), distances(n);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t k = 0; k < dim; ++k)
+            {
+                long double a = x[k][i], b = y[k][i];
+                norms[i] += a * a;
+                distances[i] += (a - b) * (a - b);
+            }
+        std::vector<T> out(n);
+        for (unsigned l = 0; l <= unsigned(eop::simd_level::avx512); ++l)
+            for (auto s : { eop::summation::naive, eop::summation::compensated })
+            {
+                auto level = eop::simd_level(l);
+                eop::squared_norms_soa(x, dim, n, out.data(), s, level);
+                for (std::size_t i = 0; i < n; ++i)
+                    EOP_CHECK(relative_error(out[i], norms[i]) <= (dim + 1) * u);
+                eop::euclidean_norms_soa(x, dim, n, out.data(), s, level);
+                for (std::size_t i = 0; i < n; ++i)
+                    EOP_CHECK(relative_error(out[i], std::sqrt(norms[i])) <= (dim + 1) * u);
+                // Differences round too
+                eop::squared_distances_soa(x, y, dim, n, out.data(), s, level);
+                for (std::size_t i = 0; i < n; ++i)
+                    EOP_CHECK(relative_error(out[i], distances[i]) <= (dim + 3) * u);
+                eop::euclidean_distances_soa(x, y, dim, n, out.data(), s, level);
+                for (std::size_t i = 0; i < n; ++i)
+                    EOP_CHECK(relative_error(out[i], std::sqrt(distances[i])) <= (dim + 3) * u);
+            }
+    };
+    check(0.0f);
+    check(0.0);
+}
+
+EOP_TEST(distinguished_points, trail_ending_on_its_last_allowed_step)
+{
+    // 1 -> 2 -> 4 -> 6 -> 8 takes exactly max_trail steps, and
+    // 3 -> 4 -> 6 -> 8 merges into it
+    eop::work_stealing_pool pool(1);
+    eop::distinguished_point_options options;
+    options.capacity = 16;
+    options.max_trail = 4;
+    options.max_walks = 2;
+    auto r = eop::distinguished_point_collision(round_up_even{},
+        [](std::uint64_t x) { return x % 8 == 0; },
+        [](std::size_t i) { return std::uint64_t(2 * i + 1); }, pool, options);
+    EOP_CHECK(r.has_value());
+    if (!r) return;
+    EOP_CHECK_EQ(std::min(r->m0, r->m1), 2u);
+    EOP_CHECK_EQ(std::max(r->m0, r->m1), 3u);
+    EOP_CHECK_EQ(r->m2, 4u);
+}
+
+EOP_TEST(pollard_rho, searches_nested_in_a_loop_and_in_small_groups)
+{
+    using U = std::uint64_t;
+    eop::work_stealing_pool pool(2);
+    // 2 has order 3 modulo 7 and order 11 modulo 23, and 4 has
+    // prime order 1048889 modulo 2097779
+    for (U k = 0; k < 3; ++k)
+        EOP_CHECK_EQ(eop::pollard_rho_log(U(2), eop::power_modulo(U(2), k, U(7)), U(7), U(3), pool), k);
+    for (U k = 0; k < 11; ++k)
+        EOP_CHECK_EQ(eop::pollard_rho_log(U(2), eop::power_modulo(U(2), k, U(23)), U(23), U(11), pool), k);
+    EOP_CHECK_EQ(eop::pollard_rho_log(U(4), U(1692085), U(2097779), U(1048889), pool), U(123457));
+
+    // Finding a factor stops only the search's own loop
+    std::atomic<int> found{0};
+    pool.parallel_for(8, 1, [&](std::size_t, std::size_t)
+    {
+        U d = eop::pollard_rho_factor(U(1000003) * U(999983), pool);
+        if (d == 1000003 || d == 999983) found.fetch_add(1);
+    });
+    EOP_CHECK_EQ(found.load(), 8);
+}
+
+EOP_TEST(tabulated, analysis_matches_orbit_structure)
+{
+    eop::tabulated<square_plus_one> t(square_plus_one{ 1000 }, 1000);
+    auto g = t.analyze();
+    for (std::uint32_t x = 0; x < 1000; ++x)
+    {
+        auto [h, c] = naive_shape(x, square_plus_one{ 1000 });
+        auto s = g.shape(x);
+        EOP_CHECK_EQ(s.m0, h);
+        EOP_CHECK_EQ(s.m1, c - 1);
+    }
+}
+
+EOP_TEST(tabulated, cycle_through_the_whole_domain)
+{
+    // One cycle of 65536 elements, a size uint16_t cannot hold
+    eop::tabulated<inc16> t{ inc16{} };
+    auto g = t.analyze();
+    EOP_CHECK_EQ(g.components(), 1u);
+    EOP_CHECK_EQ(g.cycle_size[0], 65536u);
+    for (std::uint32_t x = 0; x < 65536; x += 4099)
+    {
+        auto s = g.shape(std::uint16_t(x));
+        EOP_CHECK_EQ(s.m0, 0u);
+        EOP_CHECK_EQ(s.m1, 65535u);
+        EOP_CHECK_EQ(s.m2, x);
+    }
+}
+
+EOP_TEST(orbit_view, views_longer_than_the_distance_type)
+{
+    auto v = eop::orbit_view(std::uint8_t(0), inc8{});
+    auto c = v.until_cycle();
+    std::vector<std::uint8_t> xs;
+    for (std::uint8_t x : c) xs.push_back(x);
+    EOP_CHECK_EQ(xs.size(), 256u);
+    for (std::size_t i = 0; i < xs.size(); ++i) EOP_CHECK_EQ(xs[i], i);
+
+    // Unbounded until taken: the view does not stop at 255 elements
+    std::size_t n = 0;
+    auto i = v.begin();
+    for (; n != 1000; ++n) ++i;
+    EOP_CHECK_EQ(i.count(), 1000u);
+    EOP_CHECK_EQ(*i, std::uint8_t(1000 % 256));
+    EOP_CHECK_EQ(std::ranges::distance(v.take(700)), 700);
+    EOP_CHECK_EQ(std::ranges::distance(v.take(700).take(300)), 300);
+    EOP_CHECK_EQ(std::ranges::distance(v.until(5)), 5);
+}
+
+EOP_TEST(orbit_tables, constant_cycle_tables)
+{
+    // One cycle of 256 elements, a size uint8_t cannot hold
+    constexpr auto h = eop::analyze_domain<256>(inc8{});
+    static_assert(h.components() == 1);
+    static_assert(h.cycle_size[0] == 256);
+    static_assert(h.shape(0).m0 == 0 && h.shape(0).m1 == 255);
+    static_assert(h.shape(200).m2 == 200);
+
+    constexpr auto p = eop::analyze_domain<8>(times3_mod8{});
+    static_assert(p.components() == 5);
+    static_assert(p.cycle_size[0] == 1 && p.cycle_size[1] == 2 && p.cycle_size[2] == 2
+        && p.cycle_size[3] == 1 && p.cycle_size[4] == 2);
+    static_assert(p.shape(6).m0 == 0 && p.shape(6).m1 == 1 && p.shape(6).m2 == 6);
+
+    static_assert(eop::orbit_period(std::uint16_t(1), eop::galois_lfsr<std::uint16_t>{ 0xB400 })
+        == 65535);
+    EOP_CHECK_EQ(h.cycle_size[0], 256u);
+}
+
+EOP_TEST(jump_tables, queries_beyond_the_domain_size)
+{
+    eop::jump_table<inc16> j{ eop::tabulated<inc16>{ inc16{} } };
+    EOP_CHECK_EQ(j.power(std::uint16_t(0), 70000), std::uint16_t(70000 - 65536));
+    EOP_CHECK_EQ(j.power(std::uint16_t(3), 65536u), 3u);
+    EOP_CHECK_EQ(j.power(std::uint16_t(3), std::uint64_t(1) << 40), 3u);
+    EOP_CHECK_EQ(j.distance(10, 5), 65531u);
+    EOP_CHECK_EQ(j.distance(5, 10), 5u);
+
+    square_plus_one f{ 1000 };
+    eop::jump_table<square_plus_one> k(f, 1000);
+    for (std::uint32_t x = 0; x < 1000; x += 37)
+    {
+        for (std::uint32_t n : { 0u, 1u, 999u, 1000u, 5000u, 123457u })
+        {
+            std::uint32_t y = eop::power_unary(x, n, f);
+            EOP_CHECK_EQ(k.power(x, n), y);
+            EOP_CHECK(k.reachable(x, y));
+            EOP_CHECK_EQ(k.distance(x, y), eop::orbit_distance(x, y, f));
+        }
+    }
+}
+
+EOP_TEST(checkpointed_orbits, interrupted_walks_resume_to_the_same_result)
+{
+    // A handle of 1173 and a cycle of 116 elements
+    square_plus_one f{ 1000003 };
+    std::uint32_t x = 2;
+    std::uint32_t y = eop::power_unary(x, 1200u, f);
+    auto path = std::filesystem::temp_directory_path() / "eop_test_resume.ckpt";
+    auto interrupted = [&](std::uint64_t k, auto walk)
+    {
+        std::filesystem::remove(path);
+        try
+        {
+            interrupting_checkpoint c(path, 100, k);
+            walk(c);
+        }
+        catch (const interrupting_checkpoint::interrupted&)
+        {
+            return true;
+        }
+        return false;
+    };
+    auto distance = [&](auto& c) { return eop::orbit_distance(x, y, f, c); };
+    auto brent = [&](auto& c) { return eop::orbit_structure_brent_nonterminating_orbit(x, f, c); };
+
+    EOP_CHECK_EQ(eop::orbit_distance(x, y, f), 1200u);
+    auto shape = eop::orbit_structure_brent_nonterminating_orbit(x, f);
+    std::filesystem::remove(path);
+    eop::file_checkpoint whole(path, 100);
+    EOP_CHECK_EQ(distance(whole), 1200u);
+
+    for (std::uint64_t k : { 1, 3, 7 })
+    {
+        EOP_CHECK(interrupted(k, distance));
+        auto s = eop::orbit_distance_walk<square_plus_one>(x, y);
+        EOP_CHECK(eop::file_checkpoint(path).restore(s));
+        EOP_CHECK(s.steps >= 100 * k && s.phase != eop::orbit_phase::done);
+        eop::file_checkpoint resumed(path, 100);
+        EOP_CHECK_EQ(distance(resumed), 1200u);
+        EOP_CHECK(resumed.saves() < whole.saves());
+
+        EOP_CHECK(interrupted(k, brent));
+        auto t = eop::orbit_structure_walk<square_plus_one>(x);
+        EOP_CHECK(eop::file_checkpoint(path).restore(t));
+        EOP_CHECK(t.steps >= 100 * k && t.phase != eop::orbit_phase::done);
+        eop::file_checkpoint c(path, 100);
+        auto r = brent(c);
+        EOP_CHECK_EQ(r.m0, shape.m0);
+        EOP_CHECK_EQ(r.m1, shape.m1);
+        EOP_CHECK_EQ(r.m2, shape.m2);
+    }
+    std::filesystem::remove(path);
+}
+
+EOP_TEST(checkpointed_orbits, corrupted_or_mismatched_files_are_ignored)
+{
+    square_plus_one f{ 1000003 };
+    std::uint32_t x = 2;
+    std::uint32_t y = eop::power_unary(x, 500u, f);
+    auto path = std::filesystem::temp_directory_path() / "eop_test_mismatch.ckpt";
+    auto read = [&]
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+    };
+    auto write = [&](const std::vector<char>& b)
+    {
+        std::ofstream(path, std::ios::binary).write(b.data(), std::streamsize(b.size()));
+    };
+    auto restores = [&](auto s) { return eop::file_checkpoint(path).restore(s); };
+
+    std::filesystem::remove(path);
+    EOP_CHECK_EQ(eop::orbit_distance(x, y, f, eop::file_checkpoint(path)), 500u);
+    EOP_CHECK(restores(eop::orbit_distance_walk<square_plus_one>(x, y)));
+
+    // Another origin, target, algorithm or domain type
+    EOP_CHECK(!restores(eop::orbit_distance_walk<square_plus_one>(x + 1, y)));
+    EOP_CHECK(!restores(eop::orbit_distance_walk<square_plus_one>(x, f(y))));
+    EOP_CHECK(!restores(eop::orbit_structure_walk<square_plus_one>(x)));
+    EOP_CHECK(!restores(eop::orbit_distance_walk<inc16>(std::uint16_t(x), std::uint16_t(y))));
+
+    // Any flipped byte, or a missing one
+    std::vector<char> b = read();
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        std::vector<char> c = b;
+        c[i] = char(c[i] ^ 0x10);
+        write(c);
+        EOP_CHECK(!restores(eop::orbit_distance_walk<square_plus_one>(x, y)));
+    }
+    write(std::vector<char>(b.begin(), b.end() - 1));
+    EOP_CHECK(!restores(eop::orbit_distance_walk<square_plus_one>(x, y)));
+
+    // The walk then starts over
+    EOP_CHECK_EQ(eop::orbit_distance(x, y, f, eop::file_checkpoint(path)), 500u);
+    EOP_CHECK_EQ(read(), b);
+    std::filesystem::remove(path);
+}
+
+EOP_TEST(interleaved_orbits, lockstep_walks_match_single_walks)
+{
+    std::mt19937_64 g(7);
+    std::vector<std::uint32_t> table(5000);
+    for (std::uint32_t& v : table) v = std::uint32_t(g() % table.size());
+    auto check = [&](auto f, std::uint32_t x)
+    {
+        // Seeds on the orbit of x all reach a point on its cycle
+        std::uint32_t y = eop::power_unary(x, 10000u, f);
+        // Fewer seeds than K, and more with a shorter tail
+        for (std::size_t m : { 0, 3, 21 })
+        {
+            std::vector<std::uint32_t> seeds(m), out(m);
+            for (std::uint32_t& s : seeds) s = eop::power_unary(x, std::uint32_t(g() % 300), f);
+            eop::power_unary_interleaved<8>(seeds.begin(), seeds.end(), 777u, f, out.begin());
+            for (std::size_t i = 0; i < m; ++i)
+                EOP_CHECK_EQ(out[i], eop::power_unary(seeds[i], 777u, f));
+            eop::orbit_distances_interleaved<8>(seeds.begin(), seeds.end(), y, f, out.begin());
+            for (std::size_t i = 0; i < m; ++i)
+                EOP_CHECK_EQ(out[i], eop::orbit_distance(seeds[i], y, f));
+        }
+    };
+    static_assert(eop::is_prefetchable_transformation_v<table_step>);
+    check(table_step{ table.data() }, 1);
+    check(square_plus_one{ 100003 }, 2);
+}
+
+EOP_TEST(composition, affine_chains_fuse_and_others_nest)
+{
+    using A = eop::affine<std::uint32_t>;
+    constexpr A f{ 3, 1 }, g{ 5, 7 }, h{ 11, 2 };
+    constexpr auto fgh = eop::compose(f, g, h);
+    static_assert(std::is_same_v<decltype(fgh), const A>);
+    static_assert(fgh(9) == f(g(h(9))));
+    constexpr auto f5 = eop::iterate<5>(f);
+    static_assert(std::is_same_v<decltype(f5), const A>);
+    static_assert(f5(4) == f(f(f(f(f(4))))));
+
+    square_plus_one s{ 1009 };
+    auto sf = eop::compose(s, f);
+    static_assert(std::is_same_v<decltype(sf), eop::composed<square_plus_one, A>>);
+    static_assert(std::is_same_v<eop::domain<decltype(sf)>, std::uint32_t>);
+    static_assert(std::is_same_v<eop::distance_type<decltype(sf)>, std::uint32_t>);
+    auto s3 = eop::iterate<3>(s);
+    static_assert(std::is_same_v<decltype(s3), eop::iterated<square_plus_one, 3>>);
+    for (std::uint32_t x = 0; x < 100; ++x)
+    {
+        EOP_CHECK_EQ(sf(x), s(f(x)));
+        EOP_CHECK_EQ(s3(x), s(s(s(x))));
+        EOP_CHECK_EQ(eop::power_unary(x, 4u, s3), eop::power_unary(x, 12u, s));
+    }
+}
+
+EOP_TEST(assocops, power_and_fibonacci)
+{
+    EOP_CHECK_EQ(eop::power(3ull, 13, std::multiplies<>()), 1594323ull);
+    EOP_CHECK_EQ(eop::power_modulo(std::uint64_t(2), 64, std::uint64_t(1000000007)),
+        std::uint64_t(582344008));
+    EOP_CHECK_EQ((eop::fibonacci<std::uint64_t>(90)), 2880067194370816120ull);
+}
+
+EOP_TEST(flat_hash, set_matches_unordered_set)
+{
+    std::mt19937_64 g(1);
+    eop::flat_set<std::uint64_t> a;
+    std::unordered_set<std::uint64_t> b;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::uint64_t x = g() % 5000;
+        if (g() & 1)
+            EOP_CHECK_EQ(a.insert(x).second, b.insert(x).second);
+        else
+            EOP_CHECK_EQ(a.erase(x), b.erase(x));
+        EOP_CHECK_EQ(a.size(), b.size());
+    }
+    for (std::uint64_t x = 0; x < 5000; ++x) EOP_CHECK_EQ(a.contains(x), b.count(x) != 0);
+}
+
+EOP_TEST(flat_hash, map_heterogeneous_lookup)
+{
+    eop::flat_map<std::string, int> m;
+    m["one"] = 1;
+    m.try_emplace("two", 2);
+    EOP_CHECK_EQ(m.at("one"), 1);
+    EOP_CHECK(m.contains(std::string_view("two")));
+    EOP_CHECK(!m.contains("three"));
+}
+
+EOP_TEST(executor, parallel_for_covers_every_index_once)
+{
+    eop::work_stealing_pool pool(3);
+    std::vector<std::atomic<int>> hits(10007);
+    pool.parallel_for(hits.size(), 0, [&](std::size_t b, std::size_t e)
+    {
+        for (std::size_t i = b; i < e; ++i) hits[i].fetch_add(1);
+    });
+    for (auto& h : hits) EOP_CHECK_EQ(h.load(), 1);
+}
+
+EOP_TEST(executor, concurrent_and_nested_calls_share_a_pool)
+{
+    eop::work_stealing_pool pool(3);
+    std::vector<std::atomic<int>> hits(4000);
+    auto loop = [&](std::size_t offset)
+    {
+        for (int k = 0; k < 50; ++k)
+            pool.parallel_for(1000, 7, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t i = b; i < e; ++i) hits[offset + i].fetch_add(1);
+            });
+    };
+    std::thread t1(loop, 0), t2(loop, 1000);
+    loop(2000);
+    t1.join();
+    t2.join();
+    // Nested in the body: runs inline rather than waiting on the
+    // workers busy with the enclosing loop
+    pool.parallel_for(10, 1, [&](std::size_t b, std::size_t)
+    {
+        pool.parallel_for(100, 10, [&](std::size_t c, std::size_t d)
+        {
+            for (std::size_t i = c; i < d; ++i) hits[3000 + 100 * b + i].fetch_add(50);
+        });
+    });
+    for (auto& h : hits) EOP_CHECK_EQ(h.load(), 50);
+}
+
+EOP_TEST(executor, cancel_stops_only_the_innermost_loop)
+{
+    eop::work_stealing_pool pool(2);
+    std::atomic<int> outer{0}, inner{0};
+    pool.parallel_for(64, 1, [&](std::size_t, std::size_t)
+    {
+        pool.parallel_for(10, 1, [&](std::size_t b, std::size_t)
+        {
+            inner.fetch_add(1);
+            if (b == 2) pool.cancel();
+        });
+        outer.fetch_add(1);
+    });
+    EOP_CHECK_EQ(outer.load(), 64);
+    EOP_CHECK_EQ(inner.load(), 64 * 3);
+
+    eop::work_stealing_pool one(1);
+    int ran = 0;
+    one.parallel_for(64, 1, [&](std::size_t b, std::size_t)
+    {
+        ++ran;
+        if (b == 9) one.cancel();
+    });
+    EOP_CHECK_EQ(ran, 10);
+}
+
+EOP_TEST(instrumented, registries_used_in_turn_keep_separate_counts)
+{
+    // More registries than each thread caches, so some share a
+    // cache entry and evict each other
+    std::vector<std::unique_ptr<eop::instrument_registry>> r;
+    for (int i = 0; i < 40; ++i) r.push_back(std::make_unique<eop::instrument_registry>());
+    auto calls = [&]
+    {
+        for (int k = 0; k < 100; ++k)
+            for (std::size_t i = 0; i < r.size(); ++i)
+                for (std::size_t j = 0; j <= i % 3; ++j) r[i]->count();
+    };
+    std::thread t(calls);
+    calls();
+    t.join();
+    for (std::size_t i = 0; i < r.size(); ++i)
+        EOP_CHECK_EQ(r[i]->stats().calls, 200 * (i % 3 + 1));
+}
+
+EOP_TEST(reductions, reduce_and_scan_match_standard)
+{
+    std::vector<std::uint64_t> v(10001);
+    std::iota(v.begin(), v.end(), 1);
+    std::uint64_t s = std::accumulate(v.begin(), v.end(), std::uint64_t(0));
+    EOP_CHECK_EQ(eop::reduce(v.begin(), v.end(), std::plus<>(), std::uint64_t(0)), s);
+    EOP_CHECK_EQ(eop::reduce_balanced(v.begin(), v.end(), std::plus<>(), std::uint64_t(0)), s);
+    eop::work_stealing_pool pool(2);
+    EOP_CHECK_EQ(eop::reduce_parallel(v.begin(), v.end(), std::plus<>(), std::uint64_t(0), pool, 100), s);
+    std::vector<std::uint64_t> a(v.size()), b(v.size());
+    std::partial_sum(v.begin(), v.end(), a.begin());
+    eop::inclusive_scan_parallel(v.begin(), v.end(), b.begin(), std::plus<>(), pool, 100);
+    EOP_CHECK_EQ(a, b);
+}
+
+EOP_TEST(reductions, parallel_results_do_not_depend_on_threads)
+{
+    std::mt19937_64 g(2);
+    std::uniform_real_distribution<double> u(-1e6, 1e6);
+    std::vector<double> v(100003);
+    for (double& x : v) x = u(g);
+    eop::work_stealing_pool one(1);
+    eop::work_stealing_pool four(4);
+    EOP_CHECK_EQ(eop::reduce_parallel(v.begin(), v.end(), std::plus<>(), 0.0, one, 1000),
+              eop::reduce_parallel(v.begin(), v.end(), std::plus<>(), 0.0, four, 1000));
+}
+
+EOP_TEST(reductions, non_commutative_order_is_kept)
+{
+    std::vector<std::string> v;
+    std::string all;
+    for (int i = 0; i < 100; ++i)
+    {
+        v.push_back(std::string(1, char('a' + i % 26)));
+        all += v.back();
+    }
+    EOP_CHECK_EQ(eop::reduce(v.begin(), v.end(), std::plus<>(), std::string()), all);
+    EOP_CHECK_EQ(eop::reduce_balanced(v.begin(), v.end(), std::plus<>(), std::string()), all);
+}
+
+EOP_TEST(rearrangements, rotate_matches_standard)
+{
+    for (int n = 0; n < 40; ++n)
+        for (int k = 0; k <= n; ++k)
+        {
+            std::vector<int> v(n);
+            std::iota(v.begin(), v.end(), 0);
+            auto r = v;
+            std::rotate(r.begin(), r.begin() + k, r.end());
+            auto a = v;
+            EOP_CHECK_EQ(eop::rotate(a.begin(), a.begin() + k, a.end()), a.begin() + (n - k));
+            EOP_CHECK_EQ(a, r);
+            std::list<int> l(v.begin(), v.end());
+            eop::rotate(l.begin(), std::next(l.begin(), k), l.end());
+            EOP_CHECK(std::equal(l.begin(), l.end(), r.begin(), r.end()));
+            std::forward_list<int> fl(v.begin(), v.end());
+            eop::rotate(fl.begin(), std::next(fl.begin(), k), fl.end());
+            EOP_CHECK(std::equal(fl.begin(), fl.end(), r.begin(), r.end()));
+            if (k != 0 && k != n)
+            {
+                a = v;
+                eop::rotate_cycles(a.begin(), a.begin() + k, a.end());
+                EOP_CHECK_EQ(a, r);
+            }
+        }
+}
+
+EOP_TEST(rearrangements, reverse_forward_list)
+{
+    std::forward_list<std::string> l;
+    std::vector<std::string> r;
+    for (int i = 0; i < 50; ++i)
+    {
+        l.push_front(std::to_string(i));
+        r.push_back(std::to_string(i));
+    }
+    eop::reverse(l.begin(), l.end());
+    EOP_CHECK(std::equal(l.begin(), l.end(), r.begin(), r.end()));
+}
+
+EOP_TEST(partitions, partition_stable_matches_standard)
+{
+    std::mt19937_64 g(3);
+    for (int n : { 0, 1, 2, 17, 1000 })
+    {
+        std::vector<std::pair<int, int>> v(n);
+        for (int i = 0; i < n; ++i) v[i] = { int(g() % 2), i };
+        auto odd = [](const std::pair<int, int>& x) { return x.first == 1; };
+        auto r = v;
+        std::stable_partition(r.begin(), r.end(), [&](auto& x) { return !odd(x); });
+        auto a = v;
+        eop::partition_stable(a.begin(), a.end(), odd);
+        EOP_CHECK_EQ(a, r);
+        a = v;
+        eop::partition_stable_n(a.begin(), std::ptrdiff_t(n), odd);
+        EOP_CHECK_EQ(a, r);
+    }
+}
+
+EOP_TEST(intrinsics, ptr_construct_on_the_heap_in_an_arena_and_in_a_pool)
+{
+    using S = std::pair<int, std::string>;
+    auto u = eop::unique_ptr_construct<S>(1, std::string("one"));
+    static_assert(std::is_same_v<decltype(u), std::unique_ptr<S>>);
+    EOP_CHECK(u->first == 1 && u->second == "one");
+    auto v = eop::shared_ptr_construct<std::vector<int>>(3, 7);
+    static_assert(std::is_same_v<decltype(v), std::shared_ptr<std::vector<int>>>);
+    EOP_CHECK_EQ(*v, std::vector<int>{ 7, 7, 7 });
+
+    eop::arena a;
+    auto x = eop::ptr_construct<std::string>(a, 3, 'a');
+    EOP_CHECK_EQ(*x, "aaa");
+    eop::pool<std::string> p(4);
+    {
+        auto y = eop::ptr_construct(p, std::string("pooled"));
+        EOP_CHECK_EQ(*y, "pooled");
+        EOP_CHECK_EQ(p.live(), 1u);
+    }
+    EOP_CHECK_EQ(p.live(), 0u);
+}
+
+EOP_TEST(intrinsics, relocate_moves_unique_ptrs)
+{
+    using P = std::unique_ptr<int>;
+    std::allocator<P> alloc;
+    P* a = alloc.allocate(8);
+    P* b = alloc.allocate(8);
+    for (int i = 0; i < 8; ++i) ::new (static_cast<void*>(a + i)) P(new int(i));
+    eop::relocate(a, a + 8, b);
+    for (int i = 0; i < 8; ++i) EOP_CHECK_EQ(*b[i], i);
+    eop::destruct_range(b, b + 8);
+    alloc.deallocate(a, 8);
+    alloc.deallocate(b, 8);
+}
+
+EOP_TEST(intrinsics, destruct_applies_the_finalizer_to_every_member)
+{
+    std::vector<std::string> v{ "a", "bb", "ccc" };
+    std::string seen;
+    auto finalizer = [&seen](std::string& x) { seen += x; };
+    eop::destruct(v, finalizer);
+    EOP_CHECK_EQ(seen, "abbccc");
+    eop::construct(v, std::string("d"));
+    EOP_CHECK_EQ(v[2], "d");
+}
+
+EOP_TEST(linear_slab, handles_move_objects_exactly_once)
+{
+    using H = eop::linear_slab<std::string>::handle;
+    eop::linear_slab<std::string> s(4);
+    H a = s.emplace("alpha");
+    H b = s.emplace(3, 'b');
+    EOP_CHECK_EQ(s.live(), 2u);
+    EOP_CHECK_EQ(s[a], "alpha");
+    H c = std::move(b);
+    EOP_CHECK(!b && c);
+    EOP_CHECK_EQ(s.consume(std::move(c)), "bbb");
+    auto r = std::move(a).into_raw();
+    H d = H::from_raw(r);
+    EOP_CHECK_EQ(s[d], "alpha");
+    s.release(std::move(d));
+    EOP_CHECK_EQ(s.live(), 0u);
+
+    std::vector<H> full;
+    for (int i = 0; i < 4; ++i) full.push_back(s.emplace(i, 'x'));
+    EOP_CHECK(!s.try_emplace("none"));
+    for (H& h : full) s.release(std::move(h));
+    EOP_CHECK_EQ(s.live(), 0u);
+}
+
+#if defined(__unix__)
+EOP_TEST(linear_slab, misuse_aborts_in_checked_builds)
+{
+    using H = eop::linear_slab<int>::handle;
+    EOP_CHECK(!aborts([]
+    {
+        eop::linear_slab<int> s(2);
+        H h = s.emplace(1);
+        s.release(std::move(h));
+    }));
+    // A stale raw value, after its slot was reused
+    EOP_CHECK(aborts([]
+    {
+        eop::linear_slab<int> s(1);
+        auto r = s.emplace(1).into_raw();
+        (void)s.consume(H::from_raw(r));
+        H h = s.emplace(2);
+        H stale = H::from_raw(r);
+        (void)s[stale];
+        (void)std::move(stale).into_raw();
+        s.release(std::move(h));
+    }));
+    EOP_CHECK(aborts([]
+    {
+        eop::linear_slab<int> s(1);
+        H h = s.emplace(1);
+        H g = std::move(h);
+        (void)s.consume(std::move(h));
+        s.release(std::move(g));
+    }));
+    EOP_CHECK(aborts([]
+    {
+        eop::linear_slab<int> s(1);
+        H h = s.emplace(1);
+    }));
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    std::size_t run = 0;
+    for (const eop_test::test_case& t : eop_test::registry())
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) selected = selected || std::strcmp(argv[i], t.name) == 0;
+        if (!selected) continue;
+        std::size_t before = eop_test::failures;
+        t.run();
+        ++run;
+        std::printf("%s %s\n", eop_test::failures == before ? "[ OK ]" : "[FAIL]", t.name);
+    }
+    std::printf("%zu tests, %zu failed checks\n", run, eop_test::failures);
+    return eop_test::failures == 0 ? 0 : 1;
+}